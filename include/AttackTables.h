@@ -0,0 +1,62 @@
+#ifndef ATTACKTABLES_H_
+#define ATTACKTABLES_H_
+
+#include "Bitboard.h"
+#include "util.h"
+
+class AttackTables {
+private:
+	Bitboard _knight[64];
+	Bitboard _king[64];
+	Bitboard _pawn[2][64];
+
+public:
+	constexpr AttackTables() : _knight(), _king(), _pawn() {
+		// Every table is filled at compile time, shifting the piece bit and masking the files it would wrap around
+		for (int square = 0; square < 64; square++) {
+			Bitboard bit = 1ULL << square;
+
+			_knight[square] = ((bit << 17) & ~FILE_A) | ((bit << 15) & ~FILE_H) |
+					((bit << 10) & ~(FILE_A | FILE_B)) | ((bit << 6) & ~(FILE_G | FILE_H)) |
+					((bit >> 6) & ~(FILE_A | FILE_B)) | ((bit >> 10) & ~(FILE_G | FILE_H)) |
+					((bit >> 15) & ~FILE_A) | ((bit >> 17) & ~FILE_H);
+
+			_king[square] = (bit << 8) | (bit >> 8) |
+					((bit << 1) & ~FILE_A) | ((bit >> 1) & ~FILE_H) |
+					((bit << 9) & ~FILE_A) | ((bit << 7) & ~FILE_H) |
+					((bit >> 7) & ~FILE_A) | ((bit >> 9) & ~FILE_H);
+
+			// Black pawns move towards higher rows, white pawns towards lower ones
+			_pawn[BLACK][square] = ((bit << 9) & ~FILE_A) | ((bit << 7) & ~FILE_H);
+			_pawn[WHITE][square] = ((bit >> 7) & ~FILE_A) | ((bit >> 9) & ~FILE_H);
+		}
+	}
+
+	constexpr Bitboard getKnight(const int square) const {
+		return _knight[square];
+	}
+
+	constexpr Bitboard getKing(const int square) const {
+		return _king[square];
+	}
+
+	constexpr Bitboard getPawn(const bool color, const int square) const {
+		return _pawn[color][square];
+	}
+};
+
+inline constexpr AttackTables ATTACK_TABLES;
+
+inline Bitboard knightAttacks(const int square) {
+	return ATTACK_TABLES.getKnight(square);
+}
+
+inline Bitboard kingAttacks(const int square) {
+	return ATTACK_TABLES.getKing(square);
+}
+
+inline Bitboard pawnAttacks(const bool color, const int square) {
+	return ATTACK_TABLES.getPawn(color, square);
+}
+
+#endif /* ATTACKTABLES_H_ */
@@ -0,0 +1,21 @@
+#ifndef BENCH_H_
+#define BENCH_H_
+
+#include <string>
+#include <vector>
+#include "Game.h"
+
+class Bench {
+public:
+	const static int DEFAULT_DEPTH = 6;
+
+private:
+	std::vector<Game> _games;
+
+public:
+	Bench();
+	void addGame(const std::string moves);
+	void runScaling(const int maxThreads, const int depth, const int hashSize, const int parallelMode) const;
+};
+
+#endif /* BENCH_H_ */
@@ -0,0 +1,55 @@
+#ifndef BITBOARD_H_
+#define BITBOARD_H_
+
+#include "Position.h"
+#include "util.h"
+
+/*
+ * A bitboard holds one bit per board cell. Bit index is y*8 + x, so bit 0 is the
+ * top-left cell (black's rook corner) and bit 63 the bottom-right one.
+ */
+typedef unsigned long long Bitboard;
+
+const Bitboard FILE_A = 0x0101010101010101ULL;
+const Bitboard FILE_B = FILE_A << 1;
+const Bitboard FILE_G = FILE_A << 6;
+const Bitboard FILE_H = FILE_A << 7;
+const Bitboard ROW_0 = 0xFFULL;
+const Bitboard ROW_1 = 0xFFULL << 8;
+const Bitboard ROW_6 = 0xFFULL << 48;
+const Bitboard ROW_7 = 0xFFULL << 56;
+
+inline Bitboard squareBit(const int square) {
+	return 1ULL << square;
+}
+
+inline int toSquare(const Position position) {
+	return position.getY()*8 + position.getX();
+}
+
+inline Position toPosition(const int square) {
+	return Position(square % 8, square / 8);
+}
+
+inline int popCount(const Bitboard bitboard) {
+	return __builtin_popcountll(bitboard);
+}
+
+inline int lowestSquare(const Bitboard bitboard) {
+	return __builtin_ctzll(bitboard);
+}
+
+inline int popLowestSquare(Bitboard &bitboard) {
+	int square = __builtin_ctzll(bitboard);
+	bitboard &= bitboard - 1;
+	return square;
+}
+
+bool isPextSupported();
+void initSliderAttacks(const bool usePext);
+bool isPextEnabled();
+Bitboard rookAttacks(const int square, const Bitboard occupancy);
+Bitboard bishopAttacks(const int square, const Bitboard occupancy);
+Bitboard queenAttacks(const int square, const Bitboard occupancy);
+
+#endif /* BITBOARD_H_ */
@@ -0,0 +1,38 @@
+#ifndef BOOK_H_
+#define BOOK_H_
+
+#include <iostream>
+#include <string>
+#include "CompactMove.h"
+#include "Game.h"
+#include "MappedFile.h"
+
+/*
+ * Opening book mapped from a file of 16 byte entries sorted by key, with the Polyglot layout:
+ * big-endian key (8 bytes), move (2 bytes), weight (2 bytes) and learn data (4 bytes, unused).
+ * Keys are Game::getKey values, not Polyglot ones, since the game rules differ from chess.
+ */
+class Book {
+public:
+	const static int ENTRY_SIZE = 16;
+	const static int DEFAULT_PLIES = 16;
+	const static int MAX_WEIGHT = 65535;
+
+private:
+	MappedFile _file;
+	size_t _entries;
+
+public:
+	Book();
+	bool open(const std::string path);
+	void close();
+	bool isOpen() const;
+	size_t size() const;
+	CompactMove probe(const Game &game) const;
+	unsigned long long getKey(const size_t index) const;
+	static unsigned short toBookMove(const CompactMove move);
+	static CompactMove fromBookMove(const unsigned short bookMove);
+	static long long build(std::istream &games, std::ostream &book, const int maxPlies, const int minCount);
+};
+
+#endif /* BOOK_H_ */
@@ -2,10 +2,12 @@
 #define CANVAS_H_
 
 #include <iostream>
+#include <string>
 #include <string.h>
 #include <SDL.h>
 #include <SDL_image.h>
 #include <vector>
+#include "Game.h"
 #include "Position.h"
 #include "util.h"
 
@@ -19,21 +21,33 @@ public:
 	const static int GREEN_SQUARE_INDEX = 13;
 	const static int BLACK_WINS_INDEX = 14;
 	const static int WHITE_WINS_INDEX = 15;
+	const static int NO_SPRITE = -1;
+	const static int UNDRAWN = -2;
 
 private:
 	SDL_Window *_window;
 	SDL_Renderer *_renderer;
 	SDL_Texture* _background;
+	SDL_Texture* _board;
 	Uint32 *_buffer;
 	std::vector<SDL_Texture*> _spriteTextures;
 	SDL_Rect _spriteRect;
+	int _pieces[64];
+	int _highlights[64];
+	bool _exposed;
 
 public:
 	Canvas();
 	bool init();
+	bool createTextures();
+	void destroyTextures();
 	void close();
-	bool processEvents(Position &click) const;
-	void update(const std::string boardString, const Position initialPosition, const std::vector<Position> finalPositions);
+	bool processEvents(Position &click, const int timeout);
+	void update(const Game &game, const Position initialPosition, const std::vector<Position> &finalPositions);
+	void resetBoard();
+	void drawSquare(const int square);
+	void setStatus(const std::string status);
+	void wake() const;
 	void initBackgroundBuffer();
 	void displayWinner(const bool draw, const bool winner);
 };
@@ -0,0 +1,68 @@
+#ifndef COMPACTMOVE_H_
+#define COMPACTMOVE_H_
+
+#include <string>
+#include "Move.h"
+
+/*
+ * Move packed in 16 bits for the search: initial cell in bits 0-5, final cell in bits 6-11 and flags
+ * in bits 12-15. A move whose initial and final cells are the same is no move at all.
+ * The UI keeps using Move, converting with Game::encodeMove and toMove.
+ */
+class CompactMove {
+public:
+	const static int PROMOTION = 1;
+
+private:
+	unsigned short _data;
+
+public:
+	// Left uninitialized on purpose, so that move lists cost nothing to create
+	CompactMove() = default;
+
+	constexpr CompactMove(const int initial, const int final, const int flags = 0) :
+			_data(initial | final << 6 | flags << 12) {}
+
+	constexpr static CompactMove fromData(const unsigned short data) {
+		return CompactMove(data & 63, (data >> 6) & 63, data >> 12);
+	}
+
+	constexpr int getInitial() const {
+		return _data & 63;
+	}
+
+	constexpr int getFinal() const {
+		return (_data >> 6) & 63;
+	}
+
+	constexpr int getFlags() const {
+		return _data >> 12;
+	}
+
+	constexpr bool isPromotion() const {
+		return (_data >> 12) & PROMOTION;
+	}
+
+	constexpr bool isNone() const {
+		return getInitial() == getFinal();
+	}
+
+	constexpr unsigned short getData() const {
+		return _data;
+	}
+
+	constexpr bool operator==(const CompactMove &other) const {
+		return _data == other._data;
+	}
+
+	constexpr bool operator!=(const CompactMove &other) const {
+		return _data != other._data;
+	}
+
+	Move toMove() const;
+	std::string toAlgebraic() const;
+};
+
+constexpr CompactMove NO_MOVE(0, 0);
+
+#endif /* COMPACTMOVE_H_ */
@@ -0,0 +1,41 @@
+#ifndef ENGINE_H_
+#define ENGINE_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "CompactMove.h"
+#include "EngineProcess.h"
+#include "Game.h"
+#include "Search.h"
+
+/* Settings of an engine playing a match, with 0 for no limit */
+struct EngineOptions {
+	std::string name;
+	std::string command;
+	long long moveTime;
+	unsigned long long maxNodes;
+	int maxDepth;
+	int threads;
+	int hashSize;
+};
+
+/*
+ * Player of a headless match: this program search, or an external UCI engine when a command is given,
+ * such as another build of tools/ChessUci.cpp.
+ */
+class Engine {
+private:
+	EngineOptions _options;
+	std::unique_ptr<Search> _search;
+	EngineProcess _process;
+
+public:
+	Engine(const EngineOptions &options);
+	bool start();
+	void newGame();
+	CompactMove choose(const Game &game, const std::string fen, const std::vector<CompactMove> &moves);
+	const EngineOptions& getOptions() const;
+};
+
+#endif /* ENGINE_H_ */
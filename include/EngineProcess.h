@@ -0,0 +1,31 @@
+#ifndef ENGINEPROCESS_H_
+#define ENGINEPROCESS_H_
+
+#include <string>
+
+/*
+ * Child process talking through its standard input and output, line by line, such as a UCI engine.
+ */
+class EngineProcess {
+private:
+	std::string _buffer;
+	void *_process;
+	void *_input;
+	void *_output;
+	int _pid;
+	int _inputFd;
+	int _outputFd;
+
+public:
+	EngineProcess();
+	EngineProcess(const EngineProcess &other) = delete;
+	EngineProcess& operator=(const EngineProcess &other) = delete;
+	~EngineProcess();
+	bool start(const std::string command);
+	void close();
+	bool isRunning() const;
+	bool send(const std::string line);
+	bool readLine(std::string &line);
+};
+
+#endif /* ENGINEPROCESS_H_ */
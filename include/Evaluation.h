@@ -0,0 +1,147 @@
+#ifndef EVALUATION_H_
+#define EVALUATION_H_
+
+#include "Piece.h"
+#include "util.h"
+
+/*
+ * Piece-square tables seen from the white side, cell (0, 0) first: white pawns move towards row 0.
+ * Black pieces use the same tables mirrored vertically.
+ */
+const int PAWN_MIDDLEGAME[64] = {
+	 0,   0,   0,   0,   0,   0,   0,   0,
+	50,  50,  50,  50,  50,  50,  50,  50,
+	10,  10,  20,  30,  30,  20,  10,  10,
+	 5,   5,  10,  25,  25,  10,   5,   5,
+	 0,   0,   0,  20,  20,   0,   0,   0,
+	 5,  -5, -10,   0,   0, -10,  -5,   5,
+	 5,  10,  10, -20, -20,  10,  10,   5,
+	 0,   0,   0,   0,   0,   0,   0,   0
+};
+
+const int PAWN_ENDGAME[64] = {
+	 0,   0,   0,   0,   0,   0,   0,   0,
+	80,  80,  80,  80,  80,  80,  80,  80,
+	50,  50,  50,  50,  50,  50,  50,  50,
+	30,  30,  30,  30,  30,  30,  30,  30,
+	20,  20,  20,  20,  20,  20,  20,  20,
+	10,  10,  10,  10,  10,  10,  10,  10,
+	 0,   0,   0,   0,   0,   0,   0,   0,
+	 0,   0,   0,   0,   0,   0,   0,   0
+};
+
+const int KNIGHT_TABLE[64] = {
+	-50, -40, -30, -30, -30, -30, -40, -50,
+	-40, -20,   0,   0,   0,   0, -20, -40,
+	-30,   0,  10,  15,  15,  10,   0, -30,
+	-30,   5,  15,  20,  20,  15,   5, -30,
+	-30,   0,  15,  20,  20,  15,   0, -30,
+	-30,   5,  10,  15,  15,  10,   5, -30,
+	-40, -20,   0,   5,   5,   0, -20, -40,
+	-50, -40, -30, -30, -30, -30, -40, -50
+};
+
+const int BISHOP_TABLE[64] = {
+	-20, -10, -10, -10, -10, -10, -10, -20,
+	-10,   0,   0,   0,   0,   0,   0, -10,
+	-10,   0,   5,  10,  10,   5,   0, -10,
+	-10,   5,   5,  10,  10,   5,   5, -10,
+	-10,   0,  10,  10,  10,  10,   0, -10,
+	-10,  10,  10,  10,  10,  10,  10, -10,
+	-10,   5,   0,   0,   0,   0,   5, -10,
+	-20, -10, -10, -10, -10, -10, -10, -20
+};
+
+const int ROOK_TABLE[64] = {
+	 0,   0,   0,   0,   0,   0,   0,   0,
+	 5,  10,  10,  10,  10,  10,  10,   5,
+	-5,   0,   0,   0,   0,   0,   0,  -5,
+	-5,   0,   0,   0,   0,   0,   0,  -5,
+	-5,   0,   0,   0,   0,   0,   0,  -5,
+	-5,   0,   0,   0,   0,   0,   0,  -5,
+	-5,   0,   0,   0,   0,   0,   0,  -5,
+	 0,   0,   0,   5,   5,   0,   0,   0
+};
+
+const int QUEEN_TABLE[64] = {
+	-20, -10, -10,  -5,  -5, -10, -10, -20,
+	-10,   0,   0,   0,   0,   0,   0, -10,
+	-10,   0,   5,   5,   5,   5,   0, -10,
+	 -5,   0,   5,   5,   5,   5,   0,  -5,
+	  0,   0,   5,   5,   5,   5,   0,  -5,
+	-10,   5,   5,   5,   5,   5,   0, -10,
+	-10,   0,   5,   0,   0,   0,   0, -10,
+	-20, -10, -10,  -5,  -5, -10, -10, -20
+};
+
+const int KING_MIDDLEGAME[64] = {
+	-30, -40, -40, -50, -50, -40, -40, -30,
+	-30, -40, -40, -50, -50, -40, -40, -30,
+	-30, -40, -40, -50, -50, -40, -40, -30,
+	-30, -40, -40, -50, -50, -40, -40, -30,
+	-20, -30, -30, -40, -40, -30, -30, -20,
+	-10, -20, -20, -20, -20, -20, -20, -10,
+	 20,  20,   0,   0,   0,   0,  20,  20,
+	 20,  30,  10,   0,   0,  10,  30,  20
+};
+
+const int KING_ENDGAME[64] = {
+	-50, -40, -30, -20, -20, -30, -40, -50,
+	-30, -20, -10,   0,   0, -10, -20, -30,
+	-30, -10,  20,  30,  30,  20, -10, -30,
+	-30, -10,  30,  40,  40,  30, -10, -30,
+	-30, -10,  30,  40,  40,  30, -10, -30,
+	-30, -10,  20,  30,  30,  20, -10, -30,
+	-30, -30,   0,   0,   0,   0, -30, -30,
+	-50, -30, -30, -30, -30, -30, -30, -50
+};
+
+class Evaluation {
+public:
+	const static int MAX_PHASE = 24;
+
+private:
+	int _middlegame[2][6][64];
+	int _endgame[2][6][64];
+	int _phase[6];
+
+public:
+	constexpr Evaluation() : _middlegame(), _endgame(), _phase() {
+		// Kings are never counted as material, both are on the board until the game ends
+		const int values[6] = {Piece::BISHOP_VALUE, 0, Piece::KNIGHT_VALUE, Piece::PAWN_VALUE, Piece::QUEEN_VALUE, Piece::ROOK_VALUE};
+		const int *middlegame[6] = {BISHOP_TABLE, KING_MIDDLEGAME, KNIGHT_TABLE, PAWN_MIDDLEGAME, QUEEN_TABLE, ROOK_TABLE};
+		const int *endgame[6] = {BISHOP_TABLE, KING_ENDGAME, KNIGHT_TABLE, PAWN_ENDGAME, QUEEN_TABLE, ROOK_TABLE};
+
+		// Scores are stored from the white side, so black entries are negative
+		for (int type = 0; type < 6; type++) {
+			for (int square = 0; square < 64; square++) {
+				_middlegame[WHITE][type][square] = values[type] + middlegame[type][square];
+				_endgame[WHITE][type][square] = values[type] + endgame[type][square];
+				_middlegame[BLACK][type][square] = -(values[type] + middlegame[type][square ^ 56]);
+				_endgame[BLACK][type][square] = -(values[type] + endgame[type][square ^ 56]);
+			}
+		}
+
+		// The game gets closer to its end as knights, bishops, rooks and queens are killed
+		_phase[KNIGHT] = 1;
+		_phase[BISHOP] = 1;
+		_phase[ROOK] = 2;
+		_phase[QUEEN] = 4;
+	}
+
+	constexpr int getMiddlegame(const bool color, const int type, const int square) const {
+		return _middlegame[color][type][square];
+	}
+
+	constexpr int getEndgame(const bool color, const int type, const int square) const {
+		return _endgame[color][type][square];
+	}
+
+	constexpr int getPhase(const int type) const {
+		return _phase[type];
+	}
+};
+
+inline constexpr Evaluation EVALUATION;
+
+#endif /* EVALUATION_H_ */
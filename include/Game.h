@@ -7,42 +7,84 @@
 #include <stdlib.h>
 #include <time.h>
 #include <chrono>
+#include <vector>
+#include "AttackTables.h"
+#include "Bitboard.h"
+#include "Evaluation.h"
 #include "Player.h"
 #include "Piece.h"
-#include "Canvas.h"
+#include "CompactMove.h"
 #include "Move.h"
+#include "MoveList.h"
+#include "Zobrist.h"
 #include "util.h"
 
+/* Everything needed to take back a move made during a simulation */
+struct Undo {
+	int initial;
+	int final;
+	int captured;
+	bool promotion;
+	int noKillTurns;
+	unsigned long long key;
+	int middlegame;
+	int endgame;
+	int phase;
+};
+
+
 class Game {
 public:
 	const static int BOTVBOT = 0;
 	const static int HUMANVBOT = 1;
 	const static int HUMANVHUMAN = 2;
-	const static int MAX_SIMULATED_TURNS = 3;
+	const static int MAX_UNDO = 128;
 
 private:
 	int _turn;
 	int _mode;
 	int _noKillTurns;
-	int _simulatedTurns;
 	Player _players[2];
-	Piece _state[8][8];
+	int _board[64];
+	Undo _undoStack[MAX_UNDO];
+	int _undoCount;
+	unsigned long long _key;
+	int _middlegame;
+	int _endgame;
+	int _phase;
 
 public:
 	Game();
 	Game(const int mode);
+	Game(const Game &other);
 	Game& operator=(const Game &other);
 	void init(const int mode);
 	void initState();
-	bool run();
-	void playTurn(const Move move);
-	bool processMouseClick(Move &move, Position click) const;
-	std::tuple<Move, int> botChoice() const;
-	bool isGameOver(const Move move) const;
+	void playTurn(const CompactMove move);
+	bool playMoves(const std::string moves);
+	bool loadFen(const std::string fen);
+	std::string toFen() const;
+	void makeMove(const CompactMove move);
+	void unmakeMove();
+	bool isGameOver(const CompactMove move) const;
 	bool isLegalMove(const Move move) const;
+	CompactMove encodeMove(const Move move) const;
 	void getLegalPositions(std::vector<Position> &positions, const Position initial) const;
-	void followPawnDirection(std::vector<Position> &positions, const Position initial, const Position direction) const;
-	void followDirection(std::vector<Position> &positions, const Position initial, const Position direction) const;
+	Bitboard getLegalTargets(const int square) const;
+	void generateMoves(MoveList &moves) const;
+	void generateKills(MoveList &moves) const;
+	void addMoves(MoveList &moves, const int initial, Bitboard targets) const;
+	Piece getPiece(const Position position) const;
+	int getMode() const;
+	int getPieceType(const int square) const;
+	Bitboard getOccupancy(const bool color) const;
+	bool getActiveColor() const;
+	int getNoKillTurns() const;
+	unsigned long long getKey() const;
+	unsigned long long computeKey() const;
+	void updateEvaluation(const bool color, const int type, const int square, const int sign);
+	void computeEvaluation();
+	int evaluate() const;
 	std::string toString() const;
 };
 
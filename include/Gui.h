@@ -0,0 +1,40 @@
+#ifndef GUI_H_
+#define GUI_H_
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+#include "Canvas.h"
+#include "Game.h"
+#include "Search.h"
+
+class Gui {
+public:
+	const static int HINT_MILLISECONDS = 500;
+	const static int PROGRESS_MILLISECONDS = 100;
+
+private:
+	Canvas _canvas;
+	std::thread _searchThread;
+	std::atomic<bool> _thinking;
+	std::tuple<Move, int> _choice;
+	bool _ponder;
+	bool _pondering;
+	CompactMove _ponderMove;
+
+public:
+	Gui();
+	Gui(const bool ponder);
+	bool run(Game &game, Search &search);
+	bool processMouseClick(const Game &game, Move &move, Position click) const;
+	void think(const Game &game, Search &search);
+	void stopThinking(Search &search);
+	void startPondering(const Game &game, Search &search);
+	std::string toProgress(const Search &search) const;
+};
+
+#endif /* GUI_H_ */
@@ -0,0 +1,30 @@
+#ifndef MAPPEDFILE_H_
+#define MAPPEDFILE_H_
+
+#include <stddef.h>
+#include <string>
+
+/*
+ * Read only file mapped into memory, so that big tables are paged in by the system only where they are read
+ * and shared between every process using them.
+ */
+class MappedFile {
+private:
+	const unsigned char *_data;
+	size_t _size;
+	void *_file;
+	void *_mapping;
+
+public:
+	MappedFile();
+	MappedFile(const MappedFile &other) = delete;
+	MappedFile& operator=(const MappedFile &other) = delete;
+	~MappedFile();
+	bool open(const std::string path);
+	void close();
+	bool isOpen() const;
+	const unsigned char* getData() const;
+	size_t getSize() const;
+};
+
+#endif /* MAPPEDFILE_H_ */
@@ -0,0 +1,33 @@
+#ifndef MATCH_H_
+#define MATCH_H_
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include "Engine.h"
+#include "Game.h"
+#include "Sprt.h"
+
+class Match {
+public:
+	const static int DRAW = 2;
+	const static int DEFAULT_GAMES = 100;
+	const static int DEFAULT_MOVE_TIME = 100;
+	const static int DEFAULT_OPENING_PLIES = 4;
+
+private:
+	EngineOptions _options[2];
+	std::vector<std::string> _openings;
+	Sprt _sprt;
+	bool _sprtEnabled;
+
+public:
+	Match(const EngineOptions &first, const EngineOptions &second);
+	int loadOpenings(std::istream &input);
+	void generateOpenings(const int count, const int plies);
+	void setSprt(const Sprt &sprt, const bool enabled);
+	int playGame(Engine &white, Engine &black, const std::string fen) const;
+	int run(const int games, const int concurrency, std::ostream &output);
+};
+
+#endif /* MATCH_H_ */
@@ -11,6 +11,7 @@ private:
 public:
 	Move();
 	Move(const Position initial, const Position final);
+	Move(const std::string algebraic);
 	Move(const Move &other);
 	Move& operator=(const Move &other);
 	bool operator==(const Move &other) const;
@@ -21,6 +22,7 @@ public:
 	void setFinal(const Position newFinal);
 	void setBoth(const Position newInitial, const Position newFinal);
 	std::string toString() const;
+	std::string toAlgebraic() const;
 };
 
 #endif /* MOVE_H_ */
@@ -0,0 +1,44 @@
+#ifndef MOVELIST_H_
+#define MOVELIST_H_
+
+#include "CompactMove.h"
+
+/*
+ * Fixed capacity list of moves, meant to live on the stack of the search so that generating
+ * moves never touches the heap.
+ */
+class MoveList {
+public:
+	const static int MAX_MOVES = 256;
+
+private:
+	CompactMove _moves[MAX_MOVES];
+	int _size;
+
+public:
+	MoveList() : _size(0) {}
+
+	void add(const CompactMove move) {
+		_moves[_size++] = move;
+	}
+
+	void clear() {
+		_size = 0;
+	}
+
+	int size() const {
+		return _size;
+	}
+
+	CompactMove get(const int index) const {
+		return _moves[index];
+	}
+
+	void swap(const int first, const int second) {
+		CompactMove move = _moves[first];
+		_moves[first] = _moves[second];
+		_moves[second] = move;
+	}
+};
+
+#endif /* MOVELIST_H_ */
@@ -0,0 +1,28 @@
+#ifndef MOVEORDERING_H_
+#define MOVEORDERING_H_
+
+#include "Game.h"
+#include "MoveList.h"
+
+class MoveOrdering {
+public:
+	const static int MAX_PLY = Game::MAX_UNDO;
+	const static int HASH_SCORE = 1 << 30;
+	const static int CAPTURE_SCORE = 1 << 29;
+	const static int KILLER_SCORE = 1 << 28;
+	const static int MAX_HISTORY = 1 << 20;
+
+private:
+	CompactMove _killers[MAX_PLY][2];
+	int _history[2][64][64];
+
+public:
+	MoveOrdering();
+	void clear();
+	void age();
+	void score(const Game &game, const MoveList &moves, int scores[], const CompactMove tableMove, const int ply) const;
+	static void pick(MoveList &moves, int scores[], const int index);
+	void update(const Game &game, const CompactMove move, const int depth, const int ply);
+};
+
+#endif /* MOVEORDERING_H_ */
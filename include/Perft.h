@@ -0,0 +1,17 @@
+#ifndef PERFT_H_
+#define PERFT_H_
+
+#include <string>
+#include "Game.h"
+
+class Perft {
+public:
+	const static int DEFAULT_DEPTH = 5;
+
+public:
+	static unsigned long long count(Game &game, const int depth);
+	static unsigned long long divide(Game &game, const int depth);
+	static bool runReference(const int maxDepth);
+};
+
+#endif /* PERFT_H_ */
@@ -2,7 +2,6 @@
 #define PIECE_H_
 
 #include <string>
-#include <vector>
 #include "Position.h"
 #include "util.h"
 
@@ -10,12 +9,12 @@ class Piece {
 public:
 	const static bool DEAD = 0;
 	const static bool ALIVE = 1;
-	const static bool KING_VALUE = 1000;
-	const static bool QUEEN_VALUE = 96;
-	const static bool ROOK_VALUE = 52;
-	const static bool BISHOP_VALUE = 33;
-	const static bool KNIGHT_VALUE = 32;
-	const static bool PAWN_VALUE = 10;
+	const static int KING_VALUE = 10000;
+	const static int QUEEN_VALUE = 960;
+	const static int ROOK_VALUE = 520;
+	const static int BISHOP_VALUE = 330;
+	const static int KNIGHT_VALUE = 320;
+	const static int PAWN_VALUE = 100;
 
 private:
 	bool _alive;
@@ -33,7 +32,6 @@ public:
 	int getValue() const;
 	bool isAlive() const;
 	void setDead();
-	void getDirections(std::vector<Position> &directions) const;
 	void assignValue();
 	void toQueen();
 	std::string toString() const;
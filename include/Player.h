@@ -1,16 +1,16 @@
 #ifndef PLAYER_H_
 #define PLAYER_H_
 
-#include <vector>
-#include "Position.h"
-#include "Move.h"
+#include <string>
+#include "Bitboard.h"
 #include "util.h"
 
 class Player {
 private:
 	bool _color;
 	int _score;
-	std::vector<Position> _positions;
+	Bitboard _pieces[6];
+	Bitboard _occupancy;
 
 public:
 	Player();
@@ -18,9 +18,11 @@ public:
 	Player(const Player &other);
 	Player& operator=(const Player &other);
 	void init(const bool color);
-	std::vector<Position> getPositions() const;
-	void killPiece(const Position position);
-	void updatePosition(const Move move);
+	Bitboard getPieces(const int type) const;
+	Bitboard getOccupancy() const;
+	void addPiece(const int type, const int square);
+	void killPiece(const int type, const int square);
+	void updatePosition(const int type, const int initial, const int final);
 	std::string toString() const;
 };
 
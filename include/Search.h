@@ -0,0 +1,76 @@
+#ifndef SEARCH_H_
+#define SEARCH_H_
+
+#include <atomic>
+#include <iostream>
+#include <memory>
+#include <tuple>
+#include <vector>
+#include "Book.h"
+#include "Game.h"
+#include "Move.h"
+#include "SearchStats.h"
+#include "Tablebase.h"
+#include "TimeManager.h"
+#include "TranspositionTable.h"
+#include "Worker.h"
+
+class Search {
+public:
+	const static int MAX_DEPTH = 64;
+	const static int MAX_THREADS = 256;
+	const static int INFINITE_SCORE = 1000000;
+	const static int WIN_SCORE = 100000;
+	const static int MIN_WIN_SCORE = WIN_SCORE - Game::MAX_UNDO;
+	const static int LAZY_SMP = 0;
+	const static int SPLIT_POINTS = 1;
+
+private:
+	TranspositionTable _table;
+	Book _book;
+	Tablebase _tablebase;
+	TimeManager _timeManager;
+	std::atomic<bool> _stop;
+	std::atomic<int> _currentDepth;
+	std::atomic<int> _currentScore;
+	std::atomic<unsigned short> _currentMove;
+	std::vector<std::unique_ptr<Worker>> _workers;
+	int _parallelMode;
+	unsigned long long _probes;
+	unsigned long long _hits;
+	SearchStats _stats;
+	std::ostream *_statsOutput;
+
+public:
+	Search();
+	Search(const int hashSize);
+	void setHashSize(const int megabytes);
+	void setThreads(const int threads);
+	int getThreads() const;
+	void setParallelMode(const int mode);
+	int getParallelMode() const;
+	bool stealTask(Task &task, const int thief);
+	TranspositionTable& getTable();
+	TimeManager& getTimeManager();
+	Book& getBook();
+	Tablebase& getTablebase();
+	void stop();
+	void clearStop();
+	bool isStopped() const;
+	unsigned long long getNodes() const;
+	int getCompletedDepth() const;
+	void report(const int depth, const CompactMove move, const int score);
+	int getCurrentDepth() const;
+	int getCurrentScore() const;
+	CompactMove getCurrentMove() const;
+	unsigned long long getCurrentNodes() const;
+	double getHitRate() const;
+	void resetStats();
+	const SearchStats& getStats() const;
+	void setStatsOutput(std::ostream *output);
+	std::tuple<Move, int> botChoice(const Game &game);
+	std::tuple<Move, int> chooseMove(const Game &game);
+	static int fromTablebase(const int value, const int ply);
+};
+
+#endif /* SEARCH_H_ */
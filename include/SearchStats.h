@@ -0,0 +1,29 @@
+#ifndef SEARCHSTATS_H_
+#define SEARCHSTATS_H_
+
+#include <string>
+#include "CompactMove.h"
+
+/*
+ * Counters of one search, kept by every worker without synchronization and added up once the search ends.
+ * The branching factor is the one of the main worker: nodes of its last iteration over nodes of the one before.
+ */
+struct SearchStats {
+	CompactMove move;
+	int score;
+	int depth;
+	long long elapsed;
+	unsigned long long nodes;
+	unsigned long long quiescenceNodes;
+	unsigned long long cutoffs;
+	unsigned long long firstMoveCutoffs;
+	unsigned long long probes;
+	unsigned long long hits;
+	double branchingFactor;
+
+	SearchStats();
+	void add(const SearchStats &other);
+	std::string toJson() const;
+};
+
+#endif /* SEARCHSTATS_H_ */
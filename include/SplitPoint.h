@@ -0,0 +1,33 @@
+#ifndef SPLITPOINT_H_
+#define SPLITPOINT_H_
+
+#include <atomic>
+#include <mutex>
+#include "Game.h"
+#include "CompactMove.h"
+
+/*
+ * Node of the search whose remaining moves are shared between workers (Young Brothers Wait).
+ * It lives on the stack of the worker that created it, which waits until no task points to it.
+ */
+struct SplitPoint {
+	SplitPoint *parent;
+	Game game;
+	int depth;
+	int ply;
+	int beta;
+	std::atomic<int> alpha;
+	std::atomic<bool> cutoff;
+	std::atomic<int> pending;
+	std::mutex mutex;
+	int bestScore;
+	CompactMove bestMove;
+};
+
+/* One move of a split point, waiting to be searched by any worker */
+struct Task {
+	SplitPoint *splitPoint;
+	CompactMove move;
+};
+
+#endif /* SPLITPOINT_H_ */
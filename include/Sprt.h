@@ -0,0 +1,33 @@
+#ifndef SPRT_H_
+#define SPRT_H_
+
+/*
+ * Sequential probability ratio test between two Elo differences, H0: elo0 and H1: elo1, from the wins,
+ * draws and losses of a match (normal approximation of the trinomial score distribution, as fishtest does,
+ * with half a game of each result added).
+ */
+class Sprt {
+public:
+	const static int CONTINUE = 0;
+	const static int ACCEPT_H0 = 1;
+	const static int ACCEPT_H1 = 2;
+
+private:
+	double _elo0;
+	double _elo1;
+	double _alpha;
+	double _beta;
+
+public:
+	Sprt();
+	Sprt(const double elo0, const double elo1, const double alpha, const double beta);
+	double getLowerBound() const;
+	double getUpperBound() const;
+	double getLogLikelihoodRatio(const int wins, const int draws, const int losses) const;
+	int getState(const int wins, const int draws, const int losses) const;
+	static double toScore(const double elo);
+	static double toElo(const double score);
+	static double getEloError(const int wins, const int draws, const int losses);
+};
+
+#endif /* SPRT_H_ */
@@ -0,0 +1,47 @@
+#ifndef TABLEBASE_H_
+#define TABLEBASE_H_
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "CompactMove.h"
+#include "Game.h"
+#include "MappedFile.h"
+
+/*
+ * Endgame tables for every material with up to MAX_PIECES pieces, kings included, one file per material
+ * named like "KQvKR.tb". The first side of a name is at least as strong as the second one, and tables
+ * are probed with colors and rows swapped when the stronger side is black.
+ * Every game state takes one byte: 0 for a draw, or the number of turns until a king is killed with
+ * perfect play, odd if the active player kills it and even if the active player loses it.
+ * Results ignore the 50 turns rule, see isSound.
+ */
+class Tablebase {
+public:
+	const static int MAX_PIECES = 5;
+	const static int MAX_DISTANCE = 255;
+	const static int DRAW = 0;
+	const static int MAX_SIGNATURES = (MAX_PIECES - 1)*6*6*6;
+
+private:
+	std::map<std::string, std::unique_ptr<MappedFile>> _tables;
+	const MappedFile *_signatures[MAX_SIGNATURES];
+	int _maxPieces;
+
+public:
+	Tablebase();
+	int open(const std::string directory);
+	void close();
+	bool isOpen() const;
+	int getMaxPieces() const;
+	bool probe(const Game &game, int &value) const;
+	CompactMove probeRoot(const Game &game, int &value) const;
+	bool lookup(const int colors[], const int types[], const int squares[], const int count, const bool color,
+			int &value) const;
+	static bool isSound(const int value, const int noKillTurns);
+	static std::vector<std::string> listMaterials(const int pieces);
+	static long long generate(const std::string material, const std::string directory, long long counts[3]);
+};
+
+#endif /* TABLEBASE_H_ */
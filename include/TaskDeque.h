@@ -0,0 +1,19 @@
+#ifndef TASKDEQUE_H_
+#define TASKDEQUE_H_
+
+#include <deque>
+#include <mutex>
+#include "SplitPoint.h"
+
+class TaskDeque {
+private:
+	std::mutex _mutex;
+	std::deque<Task> _tasks;
+
+public:
+	void push(const Task &task);
+	bool popBack(Task &task, const SplitPoint *splitPoint);
+	bool steal(Task &task);
+};
+
+#endif /* TASKDEQUE_H_ */
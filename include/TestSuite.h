@@ -0,0 +1,55 @@
+#ifndef TESTSUITE_H_
+#define TESTSUITE_H_
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include "CompactMove.h"
+#include "Game.h"
+#include "Search.h"
+
+/* One game state of a test suite, with the moves a correct search should choose or avoid */
+struct TestPosition {
+	std::string id;
+	Game game;
+	std::vector<CompactMove> bestMoves;
+	std::vector<CompactMove> avoidMoves;
+};
+
+/* Result of searching one test position */
+struct TestResult {
+	CompactMove move;
+	int score;
+	int depth;
+	unsigned long long nodes;
+	long long elapsed;
+	bool solved;
+};
+
+class TestSuite {
+public:
+	const static int DEFAULT_HASH_SIZE = 16;
+
+private:
+	std::vector<TestPosition> _positions;
+	long long _moveTime;
+	unsigned long long _maxNodes;
+	int _maxDepth;
+	int _threads;
+	int _parallelMode;
+	int _hashSize;
+
+public:
+	TestSuite();
+	int load(std::istream &input);
+	bool addPosition(const std::string epd);
+	int size() const;
+	void setLimits(const long long moveTime, const unsigned long long maxNodes, const int maxDepth);
+	void setSearch(const int threads, const int parallelMode, const int hashSize);
+	bool isScored(const int index) const;
+	TestResult runPosition(Search &search, const int index) const;
+	std::vector<TestResult> run(const int jobs, std::ostream &output) const;
+	static CompactMove parseMove(const Game &game, std::string text);
+};
+
+#endif /* TESTSUITE_H_ */
@@ -0,0 +1,37 @@
+#ifndef TIMEMANAGER_H_
+#define TIMEMANAGER_H_
+
+#include <atomic>
+#include <chrono>
+
+class TimeManager {
+public:
+	const static int DEFAULT_MOVE_TIME = 1000;
+	const static int DEFAULT_MOVES_TO_GO = 30;
+
+private:
+	std::atomic<std::chrono::steady_clock::time_point> _start;
+	std::atomic<bool> _pondering;
+	long long _softLimit;
+	long long _hardLimit;
+	unsigned long long _maxNodes;
+	int _maxDepth;
+
+public:
+	TimeManager();
+	void clearLimits();
+	void setMoveTime(const long long moveTime);
+	void setClock(const long long remaining, const long long increment, const int movesToGo);
+	void setMaxNodes(const unsigned long long maxNodes);
+	void setMaxDepth(const int maxDepth);
+	int getMaxDepth() const;
+	void start();
+	void setPondering(const bool pondering);
+	void ponderHit();
+	bool isPondering() const;
+	long long getElapsed() const;
+	bool canStartIteration() const;
+	bool mustStop(const unsigned long long nodes) const;
+};
+
+#endif /* TIMEMANAGER_H_ */
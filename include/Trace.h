@@ -0,0 +1,62 @@
+#ifndef TRACE_H_
+#define TRACE_H_
+
+#include <chrono>
+#include <string>
+
+/*
+ * Timeline of the program in Chrome trace-event format, to be opened in chrome://tracing or Perfetto.
+ * Spans are only recorded when built with -DCHESS_TRACE, otherwise the TRACE_ macros compile to nothing.
+ */
+class Trace {
+public:
+	const static int MOVE_GENERATION = 0;
+	const static int TOTALS = 1;
+
+	static bool open(const std::string &path);
+	static void close();
+	static bool isEnabled();
+	static long long now();
+	static void write(const char *name, const char *category, const long long start, const long long duration,
+			const std::string args);
+	static void addTotal(const int total, const long long duration);
+	static std::string takeTotals();
+};
+
+/* Span of the timeline covering the scope where it lives */
+class TraceSpan {
+private:
+	const char *_name;
+	const char *_category;
+	long long _start;
+	std::string _args;
+
+public:
+	TraceSpan(const char *name, const char *category);
+	~TraceSpan();
+	void setArgs(const std::string args);
+};
+
+/* Time spent in the scope where it lives, added to a total of the thread instead of being a span of its own */
+class TraceTimer {
+private:
+	int _total;
+	bool _enabled;
+	std::chrono::steady_clock::time_point _start;
+
+public:
+	TraceTimer(const int total);
+	~TraceTimer();
+};
+
+#ifdef CHESS_TRACE
+#define TRACE_SPAN(name, category) TraceSpan traceSpan(name, category)
+#define TRACE_SPAN_ARGS(args) traceSpan.setArgs(args)
+#define TRACE_TOTAL(total) TraceTimer traceTimer(total)
+#else
+#define TRACE_SPAN(name, category)
+#define TRACE_SPAN_ARGS(args)
+#define TRACE_TOTAL(total)
+#endif
+
+#endif /* TRACE_H_ */
@@ -0,0 +1,49 @@
+#ifndef TRANSPOSITIONTABLE_H_
+#define TRANSPOSITIONTABLE_H_
+
+#include <atomic>
+#include <limits.h>
+#include <memory>
+#include "Bitboard.h"
+#include "CompactMove.h"
+
+class TranspositionTable {
+public:
+	const static int EXACT = 0;
+	const static int LOWER = 1;
+	const static int UPPER = 2;
+	const static int BUCKET_SIZE = 4;
+	const static int DEFAULT_SIZE = 16;
+
+private:
+	/*
+	 * data packs, from the lowest bits: move (16), depth (8), bound (2), generation (6), score (32).
+	 * check holds key ^ data, so an entry torn by two threads writing at once never matches a key.
+	 */
+	struct Entry {
+		std::atomic<unsigned long long> check;
+		std::atomic<unsigned long long> data;
+	};
+
+	/* One cache line per bucket */
+	struct alignas(64) Bucket {
+		Entry entries[BUCKET_SIZE];
+	};
+
+	std::unique_ptr<Bucket[]> _buckets;
+	unsigned long long _mask;
+	int _size;
+	int _generation;
+
+public:
+	TranspositionTable();
+	TranspositionTable(const int megabytes);
+	void resize(const int megabytes);
+	void clear();
+	void newSearch();
+	bool probe(const unsigned long long key, int &depth, int &score, int &bound, CompactMove &move) const;
+	void store(const unsigned long long key, const int depth, const int score, const int bound, const CompactMove move);
+	int getSize() const;
+};
+
+#endif /* TRANSPOSITIONTABLE_H_ */
@@ -0,0 +1,43 @@
+#ifndef UCI_H_
+#define UCI_H_
+
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include "Game.h"
+#include "Move.h"
+#include "Search.h"
+
+class Uci {
+public:
+	const static int MAX_HASH_SIZE = 65536;
+
+private:
+	Game _game;
+	Search _search;
+	std::thread _searchThread;
+	std::mutex _outputMutex;
+	std::mutex _stopMutex;
+	std::condition_variable _stopCondition;
+	bool _stopRequested;
+	bool _infinite;
+	bool _sendStats;
+
+public:
+	Uci();
+	void loop();
+	void position(std::istringstream &command);
+	void go(std::istringstream &command);
+	void setOption(std::istringstream &command);
+	void think();
+	void ponderHit();
+	void stopSearch();
+	void send(const std::string line);
+	std::string toScore(const int score) const;
+	std::string toAlgebraic(const Game &game, const Move move) const;
+};
+
+#endif /* UCI_H_ */
@@ -0,0 +1,60 @@
+#ifndef WORKER_H_
+#define WORKER_H_
+
+#include <atomic>
+#include <vector>
+#include "Game.h"
+#include "CompactMove.h"
+#include "MoveList.h"
+#include "MoveOrdering.h"
+#include "SearchStats.h"
+#include "SplitPoint.h"
+#include "TaskDeque.h"
+
+class Search;
+
+class Worker {
+public:
+	const static int MIN_SPLIT_DEPTH = 4;
+	const static int DELTA_MARGIN = 2*Piece::PAWN_VALUE;
+
+private:
+	Search &_search;
+	int _index;
+	Game _game;
+	std::vector<CompactMove> _moves;
+	unsigned long long _nodes;
+	std::atomic<unsigned long long> _reportedNodes;
+	SearchStats _stats;
+	int _completedDepth;
+	CompactMove _chosenMove;
+	int _chosenScore;
+	SplitPoint *_splitPoint;
+	TaskDeque _tasks;
+	MoveOrdering _ordering;
+
+public:
+	Worker(Search &search, const int index);
+	void init(const Game &game, const std::vector<CompactMove> &moves);
+	void iterate();
+	void help();
+	bool searchRoot(const int depth);
+	int negamax(const int depth, const int ply, int alpha, const int beta);
+	int quiescence(const int ply, int alpha, const int beta);
+	void countNode();
+	int scoreGameOver(const CompactMove move, const int ply) const;
+	void split(const int depth, const int ply, const int alpha, const int beta, int &bestScore, CompactMove &bestMove,
+			MoveList &moves, int scores[], const int first);
+	void searchTask(const Task &task);
+	void runTask(const Task &task);
+	bool steal(Task &task);
+	bool isAborted() const;
+	unsigned long long getNodes() const;
+	unsigned long long getReportedNodes() const;
+	SearchStats getStats() const;
+	int getCompletedDepth() const;
+	CompactMove getChosenMove() const;
+	int getChosenScore() const;
+};
+
+#endif /* WORKER_H_ */
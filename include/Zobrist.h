@@ -0,0 +1,46 @@
+#ifndef ZOBRIST_H_
+#define ZOBRIST_H_
+
+#include "util.h"
+
+class Zobrist {
+private:
+	unsigned long long _pieces[2][6][64];
+	unsigned long long _turn;
+
+	constexpr static unsigned long long next(unsigned long long &state) {
+		// splitmix64 step
+		unsigned long long z = (state += 0x9E3779B97F4A7C15ULL);
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+		return z ^ (z >> 31);
+	}
+
+public:
+	constexpr Zobrist() : _pieces(), _turn(0) {
+		// Keys come from a fixed seed so they are built at compile time and never change between runs
+		unsigned long long state = 0x43686573732E30ULL;
+
+		for (int color = 0; color < 2; color++) {
+			for (int type = 0; type < 6; type++) {
+				for (int square = 0; square < 64; square++) {
+					_pieces[color][type][square] = next(state);
+				}
+			}
+		}
+
+		_turn = next(state);
+	}
+
+	constexpr unsigned long long getPieceKey(const bool color, const int type, const int square) const {
+		return _pieces[color][type][square];
+	}
+
+	constexpr unsigned long long getTurnKey() const {
+		return _turn;
+	}
+};
+
+inline constexpr Zobrist ZOBRIST;
+
+#endif /* ZOBRIST_H_ */
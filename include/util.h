@@ -9,5 +9,6 @@
 #define PAWN 3
 #define QUEEN 4
 #define ROOK 5
+#define EMPTY 6
 
 #endif /* INCLUDE_UTIL_H_ */
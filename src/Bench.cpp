@@ -0,0 +1,93 @@
+#include "Bench.h"
+#include <iomanip>
+#include <iostream>
+#include "Search.h"
+
+/* Fixed set of game states, given as the moves played from the initial state */
+static const char *BENCH_GAMES[] = {
+	"",
+	"e2e4 e7e5 g1f3 b8c6 f1c4 g8f6",
+	"d2d4 d7d5 c2c4 e7e6 b1c3 g8f6 c1g5 f8e7",
+	"e2e4 c7c5 g1f3 d7d6 d2d4 c5d4 f3d4 g8f6 b1c3 a7a6",
+	"e2e4 e7e6 d2d4 d7d5 b1c3 f8b4 e4e5 c7c5 a2a3 b4c3 b2c3",
+	"e2e4 e7e5 g1f3 b8c6 d2d4 e5d4 f3d4 d8h4 b1c3 f8b4 d1d3",
+	"c2c4 e7e5 b1c3 g8f6 g2g3 d7d5 c4d5 f6d5 f1g2 d5b6",
+	"e2e4 d7d5 e4d5 d8d5 b1c3 d5a5 d2d4 g8f6 g1f3 c8f5"
+};
+
+Bench::Bench() {
+	for (auto moves : BENCH_GAMES) {
+		addGame(moves);
+	}
+}
+
+void Bench::addGame(const std::string moves) {
+	/*
+	 * Adds a game state to the benchmark set, stopping at the first illegal move.
+	 * string moves: space separated moves in "e2e4" notation, played from the initial state.
+	 */
+
+	Game game(Game::BOTVBOT);
+
+	if (!game.playMoves(moves)) {
+		std::cout << "Illegal bench moves " << moves << std::endl;
+	}
+
+	_games.push_back(game);
+}
+
+void Bench::runScaling(const int maxThreads, const int depth, const int hashSize, const int parallelMode) const {
+	/*
+	 * Searches every game state to a fixed depth with 1, 2, 4... threads, up to maxThreads,
+	 * printing nodes per second and time to depth for each thread count.
+	 * int maxThreads: biggest thread count to try.
+	 * int depth: depth searched in every game state.
+	 * int hashSize: transposition table size in megabytes.
+	 * int parallelMode: how helper threads search (Search::LAZY_SMP or Search::SPLIT_POINTS).
+	 */
+
+	Search search(hashSize);
+	unsigned long long nodes;
+	long long elapsed;
+	long long baseElapsed = 0;
+	double baseSpeed = 0;
+	double speed;
+
+	search.getTimeManager().clearLimits();
+	search.getTimeManager().setMaxDepth(depth);
+	search.setParallelMode(parallelMode);
+
+	std::cout << std::setw(8) << "threads" << std::setw(14) << "nodes" << std::setw(10) << "ms" <<
+			std::setw(12) << "nodes/s" << std::setw(10) << "nps x" << std::setw(12) << "ttd x" << std::endl;
+
+	for (int threads = 1; threads <= maxThreads; threads = threads < maxThreads && threads*2 > maxThreads ? maxThreads : threads*2) {
+		search.setThreads(threads);
+		nodes = 0;
+		elapsed = 0;
+
+		for (auto &game : _games) {
+			// Every thread count starts from the same empty table
+			search.getTable().clear();
+			search.botChoice(game);
+
+			nodes += search.getNodes();
+			elapsed += search.getTimeManager().getElapsed();
+		}
+
+		speed = elapsed > 0 ? nodes*1000.0/elapsed : 0.0;
+
+		if (threads == 1) {
+			baseElapsed = elapsed;
+			baseSpeed = speed;
+		}
+
+		std::cout << std::setw(8) << threads << std::setw(14) << nodes << std::setw(10) << elapsed <<
+				std::setw(12) << (unsigned long long) speed <<
+				std::setw(10) << std::fixed << std::setprecision(2) << (baseSpeed > 0 ? speed/baseSpeed : 0.0) <<
+				std::setw(12) << (elapsed > 0 ? (double) baseElapsed/elapsed : 0.0) << std::endl;
+
+		if (threads == maxThreads) {
+			break;
+		}
+	}
+}
@@ -0,0 +1,228 @@
+#include "Bitboard.h"
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <immintrin.h>
+#define PEXT_AVAILABLE
+#endif
+
+// Shift amounts and wrap-around masks for every ray direction (straight ones first)
+static const int RAY_SHIFTS[8] = {8, -8, 1, -1, 9, 7, -7, -9};
+static const Bitboard RAY_MASKS[8] = {~0ULL, ~0ULL, ~FILE_A, ~FILE_H, ~FILE_A, ~FILE_H, ~FILE_A, ~FILE_H};
+
+static Bitboard shift(const Bitboard bitboard, const int amount) {
+	/*
+	 * Shifts a bitboard towards higher squares if amount is positive, lower squares if not.
+	 */
+
+	return amount > 0 ? bitboard << amount : bitboard >> -amount;
+}
+
+static Bitboard rayAttacks(const int square, const Bitboard occupancy, const int first, const int last) {
+	/*
+	 * Follows the ray directions in [first, last) until a piece is found or the board ends.
+	 * Returns the bitboard of reachable cells, including the first blocking piece of each ray.
+	 */
+
+	Bitboard attacks = 0;
+	Bitboard current;
+
+	for (int i = first; i < last; i++) {
+		current = squareBit(square);
+
+		do {
+			current = shift(current, RAY_SHIFTS[i]) & RAY_MASKS[i];
+			attacks |= current;
+		} while (current && !(current & occupancy));
+	}
+
+	return attacks;
+}
+
+/* Attack lookup data of one slider on one cell */
+struct Magic {
+	Bitboard mask;
+	Bitboard magic;
+	Bitboard *attacks;
+	unsigned int shift;
+};
+
+static Magic rookMagics[64];
+static Magic bishopMagics[64];
+static Bitboard rookTable[0x19000];
+static Bitboard bishopTable[0x1480];
+static bool pextEnabled = false;
+
+// Random sequence seed of every row, chosen so that the magic search of both sliders ends quickly
+static const Bitboard ROW_SEEDS[8] = {1776, 2983, 250, 2205, 2271, 2078, 3582, 30};
+
+static Bitboard nextRandom(Bitboard &state) {
+	/*
+	 * Returns the next number of a xorshift64* sequence.
+	 */
+
+	state ^= state >> 12;
+	state ^= state << 25;
+	state ^= state >> 27;
+
+	return state * 0x2545F4914F6CDD1DULL;
+}
+
+static void initMagics(Magic magics[], Bitboard table[], const int first, const int last, const bool usePext) {
+	/*
+	 * Fills the lookup data of a slider, following the ray directions in [first, last).
+	 * Magic multipliers are searched with fixed seeds, so the tables are the same on every run.
+	 * Magic magics[]: lookup data of every cell.
+	 * Bitboard table[]: attack table shared by all cells.
+	 * bool usePext: index the table with PEXT instead of the magic multipliers.
+	 */
+
+	Bitboard occupancies[4096];
+	Bitboard references[4096];
+	int epochs[4096] = {0};
+	int epoch = 0;
+	int size;
+	int i;
+	Bitboard edges;
+	Bitboard subset;
+	Bitboard seed = 0;
+	Bitboard *attacks = table;
+
+	for (int square = 0; square < 64; square++) {
+		Magic &magic = magics[square];
+
+		if (square % 8 == 0) {
+			seed = ROW_SEEDS[square / 8];
+		}
+
+		// Edge cells never block a ray, unless the piece stands on that edge
+		edges = ((ROW_0 | ROW_7) & ~(ROW_0 << (square / 8 * 8))) | ((FILE_A | FILE_H) & ~(FILE_A << (square % 8)));
+
+		magic.mask = rayAttacks(square, 0, first, last) & ~edges;
+		magic.shift = 64 - popCount(magic.mask);
+		magic.attacks = attacks;
+
+		// Every subset of the mask, in increasing order of its PEXT index
+		size = 0;
+		subset = 0;
+
+		do {
+			occupancies[size] = subset;
+			references[size] = rayAttacks(square, subset, first, last);
+			size++;
+			subset = (subset - magic.mask) & magic.mask;
+		} while (subset);
+
+		attacks += size;
+
+		if (usePext) {
+			for (i = 0; i < size; i++) {
+				magic.attacks[i] = references[i];
+			}
+
+			continue;
+		}
+
+		// Try sparse random multipliers until one maps every subset without harmful collisions
+		do {
+			do {
+				magic.magic = nextRandom(seed) & nextRandom(seed) & nextRandom(seed);
+			} while (popCount((magic.mask * magic.magic) >> 56) < 6);
+
+			epoch++;
+
+			for (i = 0; i < size; i++) {
+				unsigned int index = ((occupancies[i] & magic.mask) * magic.magic) >> magic.shift;
+
+				if (epochs[index] < epoch) {
+					epochs[index] = epoch;
+					magic.attacks[index] = references[i];
+				} else if (magic.attacks[index] != references[i]) {
+					break;
+				}
+			}
+		} while (i < size);
+	}
+}
+
+#ifdef PEXT_AVAILABLE
+__attribute__((target("bmi2"))) static Bitboard pextAttacks(const Magic &magic, const Bitboard occupancy) {
+	/*
+	 * Returns the attacks of a slider given the board occupancy, using the PEXT instruction.
+	 */
+
+	return magic.attacks[_pext_u64(occupancy, magic.mask)];
+}
+#endif
+
+static inline Bitboard sliderAttacks(const Magic &magic, const Bitboard occupancy) {
+	/*
+	 * Returns the attacks of a slider given the board occupancy, using the table indexing chosen at startup.
+	 */
+
+#ifdef PEXT_AVAILABLE
+	if (pextEnabled) {
+		return pextAttacks(magic, occupancy);
+	}
+#endif
+
+	return magic.attacks[((occupancy & magic.mask) * magic.magic) >> magic.shift];
+}
+
+bool isPextSupported() {
+	/*
+	 * Returns true if the CPU has the BMI2 PEXT instruction.
+	 */
+
+#ifdef PEXT_AVAILABLE
+	return __builtin_cpu_supports("bmi2");
+#else
+	return false;
+#endif
+}
+
+void initSliderAttacks(const bool usePext) {
+	/*
+	 * Fills the rook and bishop attack tables, indexed with PEXT or with magic multipliers.
+	 * bool usePext: use PEXT indexing, ignored if the CPU doesn't support it.
+	 */
+
+	pextEnabled = usePext && isPextSupported();
+
+	initMagics(rookMagics, rookTable, 0, 4, pextEnabled);
+	initMagics(bishopMagics, bishopTable, 4, 8, pextEnabled);
+}
+
+bool isPextEnabled() {
+	/*
+	 * Returns true if slider attacks are indexed with PEXT, false if they use magic multipliers.
+	 */
+
+	return pextEnabled;
+}
+
+/* Tables are filled before main runs, with PEXT if the CPU supports it */
+static const bool SLIDER_ATTACKS_READY = (initSliderAttacks(true), true);
+
+Bitboard rookAttacks(const int square, const Bitboard occupancy) {
+	/*
+	 * Returns the cells a rook standing on square attacks given the board occupancy.
+	 */
+
+	return sliderAttacks(rookMagics[square], occupancy);
+}
+
+Bitboard bishopAttacks(const int square, const Bitboard occupancy) {
+	/*
+	 * Returns the cells a bishop standing on square attacks given the board occupancy.
+	 */
+
+	return sliderAttacks(bishopMagics[square], occupancy);
+}
+
+Bitboard queenAttacks(const int square, const Bitboard occupancy) {
+	/*
+	 * Returns the cells a queen standing on square attacks given the board occupancy.
+	 */
+
+	return sliderAttacks(rookMagics[square], occupancy) | sliderAttacks(bishopMagics[square], occupancy);
+}
@@ -0,0 +1,220 @@
+#include "Book.h"
+#include <algorithm>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+static unsigned long long readBigEndian(const unsigned char *bytes, const int count) {
+	/*
+	 * Returns the number stored in count bytes, most significant first.
+	 */
+
+	unsigned long long result = 0;
+
+	for (int i = 0; i < count; i++) {
+		result = result << 8 | bytes[i];
+	}
+
+	return result;
+}
+
+static void writeBigEndian(std::ostream &output, const unsigned long long value, const int count) {
+	/*
+	 * Writes a number in count bytes, most significant first.
+	 */
+
+	for (int i = count - 1; i >= 0; i--) {
+		output.put((char) ((value >> (8*i)) & 0xFF));
+	}
+}
+
+Book::Book() : _entries(0) {}
+
+bool Book::open(const std::string path) {
+	/*
+	 * Maps a book file, closing the book opened before if any.
+	 * Returns true if successful, false if the file can't be mapped or isn't made of whole entries.
+	 * string path: book file, as written by build.
+	 */
+
+	close();
+
+	if (!_file.open(path) || _file.getSize() % ENTRY_SIZE != 0) {
+		close();
+		return false;
+	}
+
+	_entries = _file.getSize()/ENTRY_SIZE;
+
+	return true;
+}
+
+void Book::close() {
+	/*
+	 * Unmaps the book file, if any.
+	 */
+
+	_file.close();
+	_entries = 0;
+}
+
+bool Book::isOpen() const {
+	/*
+	 * Returns true if a book file is mapped.
+	 */
+
+	return _file.isOpen();
+}
+
+size_t Book::size() const {
+	/*
+	 * Returns the number of entries in the book.
+	 */
+
+	return _entries;
+}
+
+unsigned long long Book::getKey(const size_t index) const {
+	/*
+	 * Returns the game state key of an entry.
+	 */
+
+	return readBigEndian(_file.getData() + index*ENTRY_SIZE, 8);
+}
+
+CompactMove Book::probe(const Game &game) const {
+	/*
+	 * Looks for the game state in the book by binary search and picks one of its moves at random,
+	 * each one with a chance proportional to its weight.
+	 * Returns the chosen move, or NO_MOVE if the game state isn't in the book.
+	 * Game game: game whose active player has to move.
+	 */
+
+	unsigned long long key = game.getKey();
+	size_t low = 0;
+	size_t high = _entries;
+	size_t middle;
+	const unsigned char *entry;
+	CompactMove moves[64];
+	int weights[64];
+	int count = 0;
+	int total = 0;
+	int choice;
+
+	// Find the first entry of the game state
+	while (low < high) {
+		middle = low + (high - low)/2;
+
+		if (getKey(middle) < key) {
+			low = middle + 1;
+		} else {
+			high = middle;
+		}
+	}
+
+	// Keep the legal moves of every entry of the game state, in case another state has the same key
+	for (size_t i = low; i < _entries && count < 64 && getKey(i) == key; i++) {
+		entry = _file.getData() + i*ENTRY_SIZE;
+		moves[count] = fromBookMove(readBigEndian(entry + 8, 2));
+		weights[count] = readBigEndian(entry + 10, 2);
+
+		if (weights[count] > 0 && !moves[count].isNone() && game.isLegalMove(moves[count].toMove())) {
+			moves[count] = game.encodeMove(moves[count].toMove());
+			total += weights[count];
+			count++;
+		}
+	}
+
+	if (total == 0) {
+		return NO_MOVE;
+	}
+
+	choice = rand() % total;
+
+	for (int i = 0; i < count; i++) {
+		if (choice < weights[i]) {
+			return moves[i];
+		}
+
+		choice -= weights[i];
+	}
+
+	return moves[count - 1];
+}
+
+unsigned short Book::toBookMove(const CompactMove move) {
+	/*
+	 * Returns the move as Polyglot stores it: final square in bits 0-5 and initial square in bits 6-11,
+	 * both counted from a1 instead of a8, and 4 (queen) in bits 12-14 for promotions.
+	 */
+
+	return (move.getFinal() ^ 56) | (move.getInitial() ^ 56) << 6 | (move.isPromotion() ? 4 << 12 : 0);
+}
+
+CompactMove Book::fromBookMove(const unsigned short bookMove) {
+	/*
+	 * Returns the move stored in Polyglot format, see toBookMove.
+	 */
+
+	return CompactMove(((bookMove >> 6) & 63) ^ 56, (bookMove & 63) ^ 56, (bookMove >> 12) & 7 ? CompactMove::PROMOTION : 0);
+}
+
+long long Book::build(std::istream &games, std::ostream &book, const int maxPlies, const int minCount) {
+	/*
+	 * Writes a book with the moves played in recorded games, weighted by how many times they were played.
+	 * Returns the number of entries written, or -1 if writing failed.
+	 * istream games: one game per line, as moves in "e2e4" notation. Every game is read until the
+	 * first illegal move, such as a move of the wrong side, or word, so results or comments may follow the moves.
+	 * ostream book: binary output for the book.
+	 * int maxPlies: turns of every game added to the book.
+	 * int minCount: times a move must have been played in a game state to be added.
+	 */
+
+	std::vector<std::pair<unsigned long long, unsigned short>> played;
+	std::string line;
+	std::string token;
+	long long entries = 0;
+	int count;
+
+	while (std::getline(games, line)) {
+		std::istringstream moves(line);
+		Game game(Game::BOTVBOT);
+
+		for (int ply = 0; ply < maxPlies && moves >> token; ply++) {
+			Move move(token);
+
+			if (move.getInitial() == Position(-1, -1) || !game.isLegalMove(move)) {
+				break;
+			}
+
+			played.push_back(std::make_pair(game.getKey(), toBookMove(game.encodeMove(move))));
+
+			if (game.isGameOver(game.encodeMove(move))) {
+				break;
+			}
+
+			game.playTurn(game.encodeMove(move));
+		}
+	}
+
+	// Equal moves of the same game state end up together, in key order as probe needs them
+	std::sort(played.begin(), played.end());
+
+	for (size_t i = 0; i < played.size(); i += count) {
+		count = 1;
+
+		while (i + count < played.size() && played[i + count] == played[i]) {
+			count++;
+		}
+
+		if (count >= minCount) {
+			writeBigEndian(book, played[i].first, 8);
+			writeBigEndian(book, played[i].second, 2);
+			writeBigEndian(book, std::min(count, (int) MAX_WEIGHT), 2);
+			writeBigEndian(book, 0, 4);
+			entries++;
+		}
+	}
+
+	return book ? entries : -1;
+}
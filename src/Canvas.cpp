@@ -1,6 +1,7 @@
 #include "Canvas.h"
+#include "Trace.h"
 
-Canvas::Canvas() : _window(NULL), _renderer(NULL), _background(NULL), _buffer(NULL) {}
+Canvas::Canvas() : _window(NULL), _renderer(NULL), _background(NULL), _board(NULL), _buffer(NULL), _exposed(true) {}
 
 bool Canvas::init() {
 	/*
@@ -21,20 +22,52 @@ bool Canvas::init() {
 	}
 
 	// Initialize renderer and check if successful
-	_renderer = SDL_CreateRenderer(_window, -1, SDL_RENDERER_PRESENTVSYNC);
+	_renderer = SDL_CreateRenderer(_window, -1, SDL_RENDERER_PRESENTVSYNC | SDL_RENDERER_TARGETTEXTURE);
 	if (_renderer == NULL) {
 		return false;
 	}
 
+	// Initialize buffer, copied to the background when the textures are created
+	_buffer = new Uint32[CANVAS_WIDTH*CANVAS_HEIGHT];
+	initBackgroundBuffer();
+
+	// Initialize textures and check if successful
+	IMG_Init(IMG_INIT_PNG);
+
+	if (!createTextures()) {
+		return false;
+	}
+
+	// Initialize spriteRect
+	_spriteRect.w = CANVAS_WIDTH/8;
+	_spriteRect.h = CANVAS_HEIGHT/8;
+
+	// Nothing drawn on the board texture yet
+	resetBoard();
+
+	return true;
+}
+
+bool Canvas::createTextures() {
+	/*
+	 * Creates the background, board and sprite textures for the renderer.
+	 * Returns true if successful, false if not.
+	 */
+
 	// Initialize background and check if successful
 	_background = SDL_CreateTexture(_renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_STATIC, CANVAS_WIDTH, CANVAS_HEIGHT);
 	if (_background == NULL) {
 		return false;
 	}
+	SDL_UpdateTexture(_background, NULL, _buffer, CANVAS_WIDTH*sizeof(Uint32));
 
-	// Initialize sprite textures
-	IMG_Init(IMG_INIT_PNG);
+	// Initialize board texture, which keeps the drawn squares between updates, and check if successful
+	_board = SDL_CreateTexture(_renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, CANVAS_WIDTH, CANVAS_HEIGHT);
+	if (_board == NULL) {
+		return false;
+	}
 
+	// Initialize sprite textures
 	_spriteTextures.push_back(IMG_LoadTexture(_renderer, "blackBishop.png"));
 	_spriteTextures.push_back(IMG_LoadTexture(_renderer, "blackKing.png"));
 	_spriteTextures.push_back(IMG_LoadTexture(_renderer, "blackKnight.png"));
@@ -52,23 +85,12 @@ bool Canvas::init() {
 	_spriteTextures.push_back(IMG_LoadTexture(_renderer, "blackWins.png"));
 	_spriteTextures.push_back(IMG_LoadTexture(_renderer, "whiteWins.png"));
 
-
-	// Initialize buffer and copy to background
-	_buffer = new Uint32[CANVAS_WIDTH*CANVAS_HEIGHT];
-	initBackgroundBuffer();
-	SDL_UpdateTexture(_background, NULL, _buffer, CANVAS_WIDTH*sizeof(Uint32));
-
-	// Initialize spriteRect
-	_spriteRect.w = CANVAS_WIDTH/8;
-	_spriteRect.h = CANVAS_HEIGHT/8;
-
-
 	return true;
 }
 
-void Canvas::close() {
+void Canvas::destroyTextures() {
 	/*
-	 * Free all memory allocated for canvas.
+	 * Frees the background, board and sprite textures.
 	 */
 
 	for (auto texture : _spriteTextures) {
@@ -81,10 +103,25 @@ void Canvas::close() {
 	_spriteTextures.clear();
 	_spriteTextures.shrink_to_fit();
 
+	// Check if board texture already deallocated to free it
+	if (_board != NULL) {
+		SDL_DestroyTexture(_board);
+		_board = NULL;
+	}
+
 	// Check if background already deallocated to free it
 	if (_background != NULL) {
 		SDL_DestroyTexture(_background);
+		_background = NULL;
 	}
+}
+
+void Canvas::close() {
+	/*
+	 * Free all memory allocated for canvas.
+	 */
+
+	destroyTextures();
 
 	// Check if renderer already deallocated to free it
 	if (_renderer != NULL) {
@@ -104,76 +141,167 @@ void Canvas::close() {
 	delete [] _buffer;
 }
 
-bool Canvas::processEvents(Position &click) const {
+bool Canvas::processEvents(Position &click, const int timeout) {
 	/*
-	 * Process events within canvas.
-	 * Returns false if "Quit" button is clicked, true if not.
+	 * Process events within canvas, waiting for the first one so that an idle canvas doesn't use the CPU.
+	 * Returns false if "Quit" button is clicked or the textures can't be recreated after a device reset, true if not.
+	 * int timeout: milliseconds to wait for an event, 0 to return at once or negative to wait forever.
 	 */
 
+	TRACE_SPAN("Canvas::processEvents", "events");
+
 	SDL_Event event;
+	int received;
+
+	// Wait for the first event, then process every event in queue (the wait is traced apart, as a "wait" span of the "idle" category)
+	{
+		TRACE_SPAN("wait", "idle");
 
-	// Check if events in queue
-	while (SDL_PollEvent(&event)) {
+		if (timeout < 0) {
+			received = SDL_WaitEvent(&event);
+		} else if (timeout > 0) {
+			received = SDL_WaitEventTimeout(&event, timeout);
+		} else {
+			received = SDL_PollEvent(&event);
+		}
+	}
+
+	while (received) {
 		if (event.type == SDL_QUIT) {
 			return false;
 		} else if (event.type == SDL_MOUSEBUTTONUP) {
 			click.setBoth(event.button.x, event.button.y);
+		} else if (event.type == SDL_WINDOWEVENT && event.window.event == SDL_WINDOWEVENT_EXPOSED) {
+			_exposed = true;
+		} else if (event.type == SDL_RENDER_TARGETS_RESET || event.type == SDL_RENDER_DEVICE_RESET) {
+			// The board texture lost its contents, and every texture is gone if the device was reset
+			if (event.type == SDL_RENDER_DEVICE_RESET) {
+				destroyTextures();
+
+				if (!createTextures()) {
+					return false;
+				}
+			}
+
+			resetBoard();
 		}
+
+		received = SDL_PollEvent(&event);
 	}
 
 	return true;
 }
 
-void Canvas::update(const std::string boardString, const Position initialPosition, const std::vector<Position> finalPositions) {
+void Canvas::update(const Game &game, const Position initialPosition, const std::vector<Position> &finalPositions) {
 	/*
-	 * Updates drawings in canvas.
-	 * string boardString: Current board disposition.
+	 * Updates drawings in canvas, redrawing only the squares that changed since the last update.
+	 * Nothing is presented if no square changed and the window wasn't exposed.
+	 * Game game: game whose board is drawn.
+	 * Position initialPosition: selected position, or (-1, -1) if none.
+	 * vector<Position> finalPositions: legal final positions of the selected piece.
 	 */
 
-	int textureIndex;
-
-	// Clear renderer
-	SDL_RenderClear(_renderer);
+	TRACE_SPAN("Canvas::update", "render");
 
-	// Copy background to renderer
-	SDL_RenderCopy(_renderer, _background, NULL, NULL);
+	int highlights[64];
+	bool dirty = false;
+	int piece;
 
-	// Copy initial position square to renderer if needed
-	if (initialPosition != Position(-1, -1)) {
-		_spriteRect.x = initialPosition.getX()*CANVAS_WIDTH/8;
-		_spriteRect.y = initialPosition.getY()*CANVAS_HEIGHT/8;
-		SDL_RenderCopy(_renderer, _spriteTextures[BLUE_SQUARE_INDEX], NULL, &_spriteRect);
+	for (int square = 0; square < 64; square++) {
+		highlights[square] = NO_SPRITE;
 	}
 
-	// Copy final position squares to renderer if needed
 	for (unsigned int i = 0; i < finalPositions.size(); i++) {
-		_spriteRect.x = finalPositions[i].getX()*CANVAS_WIDTH/8;
-		_spriteRect.y = finalPositions[i].getY()*CANVAS_HEIGHT/8;
-		SDL_RenderCopy(_renderer, _spriteTextures[GREEN_SQUARE_INDEX], NULL, &_spriteRect);
+		highlights[toSquare(finalPositions[i])] = GREEN_SQUARE_INDEX;
 	}
 
-	// Iterate through boardString
-	for (int i = 0; i < 8; i++) {
-		for (int j = 0; j < 8; j++) {
-			// Set piece position in canvas
-			_spriteRect.x = j*CANVAS_WIDTH/8;
-			_spriteRect.y = i*CANVAS_HEIGHT/8;
-
-			// Read piece type from boardString
-			textureIndex = boardString[2*j + 16*i + 1] - '0';
-
-			// Read piece color from boardString and copy sprite texture to renderer
-			if (boardString[2*j + 16*i] == WHITE + '0') {
-				textureIndex += 6;
-				SDL_RenderCopy(_renderer, _spriteTextures[textureIndex], NULL, &_spriteRect);
-			} else if (boardString[2*j + 16*i] == BLACK + '0') {
-				SDL_RenderCopy(_renderer, _spriteTextures[textureIndex], NULL, &_spriteRect);
-			}
+	if (initialPosition != Position(-1, -1)) {
+		highlights[toSquare(initialPosition)] = BLUE_SQUARE_INDEX;
+	}
+
+	// Draw changed squares into the board texture
+	SDL_SetRenderTarget(_renderer, _board);
+
+	for (int square = 0; square < 64; square++) {
+		piece = game.getPieceType(square);
+
+		if (piece == EMPTY) {
+			piece = NO_SPRITE;
+		} else if (game.getOccupancy(WHITE) & squareBit(square)) {
+			piece += 6;
+		}
+
+		if (piece != _pieces[square] || highlights[square] != _highlights[square]) {
+			_pieces[square] = piece;
+			_highlights[square] = highlights[square];
+			drawSquare(square);
+			dirty = true;
 		}
 	}
 
-	// Draw renderer into the window
-	SDL_RenderPresent(_renderer);
+	SDL_SetRenderTarget(_renderer, NULL);
+
+	// Copy the board texture to the window only if it changed or the window needs it
+	if (dirty || _exposed) {
+		SDL_RenderCopy(_renderer, _board, NULL, NULL);
+		SDL_RenderPresent(_renderer);
+		_exposed = false;
+	}
+}
+
+void Canvas::resetBoard() {
+	/*
+	 * Marks every square of the board texture as undrawn, so the next update redraws and presents them all.
+	 */
+
+	for (int square = 0; square < 64; square++) {
+		_pieces[square] = UNDRAWN;
+		_highlights[square] = UNDRAWN;
+	}
+
+	_exposed = true;
+}
+
+void Canvas::drawSquare(const int square) {
+	/*
+	 * Draws background, highlight and piece of a square into the current render target.
+	 * int square: index of the square, as stored in _pieces and _highlights.
+	 */
+
+	_spriteRect.x = (square % 8)*CANVAS_WIDTH/8;
+	_spriteRect.y = (square / 8)*CANVAS_HEIGHT/8;
+
+	// Copy background square
+	SDL_RenderCopy(_renderer, _background, &_spriteRect, &_spriteRect);
+
+	if (_highlights[square] != NO_SPRITE) {
+		SDL_RenderCopy(_renderer, _spriteTextures[_highlights[square]], NULL, &_spriteRect);
+	}
+
+	if (_pieces[square] != NO_SPRITE) {
+		SDL_RenderCopy(_renderer, _spriteTextures[_pieces[square]], NULL, &_spriteRect);
+	}
+}
+
+void Canvas::setStatus(const std::string status) {
+	/*
+	 * Shows a status line in the window title.
+	 * string status: text shown after the game name, nothing if empty.
+	 */
+
+	SDL_SetWindowTitle(_window, status.empty() ? "CHESS" : ("CHESS - " + status).c_str());
+}
+
+void Canvas::wake() const {
+	/*
+	 * Wakes up a processEvents call waiting for events. Can be called from any thread.
+	 */
+
+	SDL_Event event;
+
+	memset(&event, 0, sizeof(event));
+	event.type = SDL_USEREVENT;
+	SDL_PushEvent(&event);
 }
 
 void Canvas::initBackgroundBuffer() {
@@ -246,6 +374,9 @@ void Canvas::displayWinner(const bool draw, const bool winner) {
 	 * bool winner: winner of the game.
 	 */
 
+	// Start from the last drawn board, the window contents are lost after every present
+	SDL_RenderCopy(_renderer, _board, NULL, NULL);
+
 	if (!draw) {
 		_spriteRect.x = CANVAS_WIDTH/2 - 375;
 		_spriteRect.y = CANVAS_HEIGHT/2 - 100;
@@ -257,8 +388,8 @@ void Canvas::displayWinner(const bool draw, const bool winner) {
 			SDL_RenderCopy(_renderer, _spriteTextures[WHITE_WINS_INDEX], NULL, &_spriteRect);
 		}
 
-		_spriteRect.w = 50;
-		_spriteRect.h = 50;
+		_spriteRect.w = CANVAS_WIDTH/8;
+		_spriteRect.h = CANVAS_HEIGHT/8;
 	}
 
 	SDL_RenderPresent(_renderer);
@@ -1,16 +1,118 @@
+#include "Bench.h"
+#include <fstream>
+#include <iostream>
+#include <string.h>
 #include "Game.h"
+#include "Gui.h"
+#include "Search.h"
+#include "Trace.h"
 
 using namespace std;
 
 int main(int argc, char* argv[]) {
+	int hashSize = TranspositionTable::DEFAULT_SIZE;
+	long long moveTime = TimeManager::DEFAULT_MOVE_TIME;
+	unsigned long long maxNodes = 0;
+	int maxDepth = 0;
+	int threads = 1;
+	int benchThreads = 0;
+	int parallelMode = Search::LAZY_SMP;
+	int mode = Game::BOTVBOT;
+	bool ponder = false;
+	string bookPath;
+	string tablebasePath;
+	string statsPath;
+	string tracePath;
+	ofstream stats;
+
+	// Read command line options
+	for (int i = 1; i + 1 < argc; i += 2) {
+		if (strcmp(argv[i], "-hash") == 0) {
+			hashSize = atoi(argv[i + 1]);
+		} else if (strcmp(argv[i], "-movetime") == 0) {
+			moveTime = atoll(argv[i + 1]);
+		} else if (strcmp(argv[i], "-nodes") == 0) {
+			maxNodes = strtoull(argv[i + 1], NULL, 10);
+		} else if (strcmp(argv[i], "-depth") == 0) {
+			maxDepth = atoi(argv[i + 1]);
+		} else if (strcmp(argv[i], "-threads") == 0) {
+			threads = atoi(argv[i + 1]);
+		} else if (strcmp(argv[i], "-bench") == 0) {
+			benchThreads = atoi(argv[i + 1]);
+		} else if (strcmp(argv[i], "-parallel") == 0) {
+			parallelMode = strcmp(argv[i + 1], "split") == 0 ? Search::SPLIT_POINTS : Search::LAZY_SMP;
+		} else if (strcmp(argv[i], "-mode") == 0) {
+			if (strcmp(argv[i + 1], "humanvbot") == 0) {
+				mode = Game::HUMANVBOT;
+			} else if (strcmp(argv[i + 1], "humanvhuman") == 0) {
+				mode = Game::HUMANVHUMAN;
+			} else {
+				mode = Game::BOTVBOT;
+			}
+		} else if (strcmp(argv[i], "-book") == 0) {
+			bookPath = argv[i + 1];
+		} else if (strcmp(argv[i], "-tablebases") == 0) {
+			tablebasePath = argv[i + 1];
+		} else if (strcmp(argv[i], "-stats") == 0) {
+			statsPath = argv[i + 1];
+		} else if (strcmp(argv[i], "-trace") == 0) {
+			tracePath = argv[i + 1];
+		} else if (strcmp(argv[i], "-ponder") == 0) {
+			ponder = strcmp(argv[i + 1], "on") == 0;
+		}
+	}
+
+	// Print the thread scaling report instead of playing
+	if (benchThreads > 0) {
+		Bench().runScaling(benchThreads, maxDepth > 0 ? maxDepth : Bench::DEFAULT_DEPTH, hashSize, parallelMode);
+		return 0;
+	}
+
+	Search search(hashSize);
+	search.getTimeManager().setMoveTime(moveTime);
+	search.getTimeManager().setMaxNodes(maxNodes);
+	search.getTimeManager().setMaxDepth(maxDepth);
+	search.setThreads(threads);
+	search.setParallelMode(parallelMode);
+
+	if (!bookPath.empty() && !search.getBook().open(bookPath)) {
+		cout << "Error opening book " << bookPath << "!" << endl;
+	}
+
+	if (!tablebasePath.empty() && search.getTablebase().open(tablebasePath) == 0) {
+		cout << "Error opening tablebases " << tablebasePath << "!" << endl;
+	}
+
+	// One JSON line per bot move, to the console or appended to a file
+	if (statsPath == "-") {
+		search.setStatsOutput(&cout);
+	} else if (!statsPath.empty()) {
+		stats.open(statsPath, ios::app);
+
+		if (stats) {
+			search.setStatsOutput(&stats);
+		} else {
+			cout << "Error opening stats file " << statsPath << "!" << endl;
+		}
+	}
+
+	if (!tracePath.empty() && !Trace::open(tracePath)) {
+		cout << "Error opening trace " << tracePath << " (tracing needs a build with -DCHESS_TRACE)!" << endl;
+	}
 
 	while (true) {
-		Game game(Game::BOTVBOT);
+		Game game(mode);
 
-		if (!game.run()) {
+		if (!Gui(ponder).run(game, search)) {
 			break;
 		}
+
+		// Report how often the bot found already searched game states
+		cout << "Hash hit rate: " << search.getHitRate()*100 << "%" << endl;
+		search.resetStats();
 	}
 
+	Trace::close();
+
 	return 0;
 }
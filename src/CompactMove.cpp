@@ -0,0 +1,26 @@
+#include "CompactMove.h"
+#include "Bitboard.h"
+
+Move CompactMove::toMove() const {
+	/*
+	 * Returns the move with positions, as the UI uses it, or (-1, -1) -> (-1, -1) if there is no move.
+	 */
+
+	if (isNone()) {
+		return Move(Position(-1, -1), Position(-1, -1));
+	}
+
+	return Move(toPosition(getInitial()), toPosition(getFinal()));
+}
+
+std::string CompactMove::toAlgebraic() const {
+	/*
+	 * Returns the move in "e2e4" notation, adding "q" if a pawn turns into a queen, or "0000" if there is no move.
+	 */
+
+	if (isNone()) {
+		return "0000";
+	}
+
+	return toMove().toAlgebraic() + (isPromotion() ? "q" : "");
+}
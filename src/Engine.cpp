@@ -0,0 +1,127 @@
+#include "Engine.h"
+#include <sstream>
+
+Engine::Engine(const EngineOptions &options) : _options(options) {}
+
+bool Engine::start() {
+	/*
+	 * Sets up the search, or starts the external engine and waits until it is ready.
+	 * Returns true if successful, false if the external engine can't be started or doesn't speak UCI.
+	 */
+
+	std::string line;
+
+	if (_options.command.empty()) {
+		_search.reset(new Search(_options.hashSize));
+		_search->getTimeManager().clearLimits();
+		_search->getTimeManager().setMoveTime(_options.moveTime);
+		_search->getTimeManager().setMaxNodes(_options.maxNodes);
+		_search->getTimeManager().setMaxDepth(_options.maxDepth);
+		_search->setThreads(_options.threads);
+
+		return true;
+	}
+
+	if (!_process.start(_options.command) || !_process.send("uci")) {
+		return false;
+	}
+
+	while (line != "uciok") {
+		if (!_process.readLine(line)) {
+			return false;
+		}
+	}
+
+	_process.send("setoption name Hash value " + std::to_string(_options.hashSize));
+	_process.send("setoption name Threads value " + std::to_string(_options.threads));
+
+	if (!_process.send("isready")) {
+		return false;
+	}
+
+	while (line != "readyok") {
+		if (!_process.readLine(line)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void Engine::newGame() {
+	/*
+	 * Forgets everything learnt in the previous game, so that games don't depend on the order they are played.
+	 */
+
+	if (_search) {
+		_search->getTable().clear();
+	} else {
+		_process.send("ucinewgame");
+	}
+}
+
+CompactMove Engine::choose(const Game &game, const std::string fen, const std::vector<CompactMove> &moves) {
+	/*
+	 * Chooses the move of the active player.
+	 * Returns the chosen move, or NO_MOVE if the external engine gave no legal move.
+	 * Game game: game whose active player has to move, which must have legal moves.
+	 * string fen: game state where the game started, for the external engine.
+	 * vector<CompactMove> moves: moves played since then, for the external engine.
+	 */
+
+	std::string line = "position fen " + fen;
+	std::string token;
+
+	if (_search) {
+		Move move = std::get<0>(_search->botChoice(game));
+
+		return move.getInitial() == Position(-1, -1) ? NO_MOVE : game.encodeMove(move);
+	}
+
+	if (!moves.empty()) {
+		line += " moves";
+
+		for (auto &move : moves) {
+			line += " " + move.toAlgebraic();
+		}
+	}
+
+	_process.send(line);
+	line = "go";
+
+	if (_options.moveTime > 0) {
+		line += " movetime " + std::to_string(_options.moveTime);
+	}
+
+	if (_options.maxNodes > 0) {
+		line += " nodes " + std::to_string(_options.maxNodes);
+	}
+
+	if (_options.maxDepth > 0) {
+		line += " depth " + std::to_string(_options.maxDepth);
+	}
+
+	_process.send(line);
+
+	// Skip the search information until the move comes
+	while (_process.readLine(line)) {
+		std::istringstream words(line);
+
+		if (words >> token && token == "bestmove" && words >> token) {
+			Move move(token);
+
+			// Moves of the opponent's pieces are illegal too, so the engine forfeits instead of corrupting the game
+			return move.getInitial() != Position(-1, -1) && game.isLegalMove(move) ? game.encodeMove(move) : NO_MOVE;
+		}
+	}
+
+	return NO_MOVE;
+}
+
+const EngineOptions& Engine::getOptions() const {
+	/*
+	 * Returns the settings of the engine.
+	 */
+
+	return _options;
+}
@@ -0,0 +1,246 @@
+#include "EngineProcess.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+EngineProcess::EngineProcess() : _process(NULL), _input(NULL), _output(NULL), _pid(-1), _inputFd(-1), _outputFd(-1) {}
+
+EngineProcess::~EngineProcess() {
+	close();
+}
+
+bool EngineProcess::start(const std::string command) {
+	/*
+	 * Starts a process through the system shell, closing the process started before if any.
+	 * Returns true if successful, false if the process can't be created.
+	 * string command: command line of the process.
+	 */
+
+	close();
+
+#ifdef _WIN32
+	SECURITY_ATTRIBUTES attributes = {sizeof(SECURITY_ATTRIBUTES), NULL, TRUE};
+	HANDLE childInput, input, output, childOutput;
+	STARTUPINFOA startup;
+	PROCESS_INFORMATION information;
+	std::string line = "cmd /c " + command;
+
+	if (!CreatePipe(&childInput, &input, &attributes, 0)) {
+		return false;
+	}
+
+	if (!CreatePipe(&output, &childOutput, &attributes, 0)) {
+		CloseHandle(childInput);
+		CloseHandle(input);
+		return false;
+	}
+
+	// Only the child ends of the pipes are inherited
+	SetHandleInformation(input, HANDLE_FLAG_INHERIT, 0);
+	SetHandleInformation(output, HANDLE_FLAG_INHERIT, 0);
+
+	ZeroMemory(&startup, sizeof(startup));
+	startup.cb = sizeof(startup);
+	startup.dwFlags = STARTF_USESTDHANDLES;
+	startup.hStdInput = childInput;
+	startup.hStdOutput = childOutput;
+	startup.hStdError = GetStdHandle(STD_ERROR_HANDLE);
+
+	bool created = CreateProcessA(NULL, &line[0], NULL, NULL, TRUE, CREATE_NO_WINDOW, NULL, NULL, &startup, &information);
+
+	CloseHandle(childInput);
+	CloseHandle(childOutput);
+
+	if (!created) {
+		CloseHandle(input);
+		CloseHandle(output);
+		return false;
+	}
+
+	CloseHandle(information.hThread);
+	_process = information.hProcess;
+	_input = input;
+	_output = output;
+#else
+	int input[2];
+	int output[2];
+
+	if (pipe(input) < 0) {
+		return false;
+	}
+
+	if (pipe(output) < 0) {
+		::close(input[0]);
+		::close(input[1]);
+		return false;
+	}
+
+	// Processes started later must not inherit these pipes, or they would keep them open
+	for (int fd : {input[0], input[1], output[0], output[1]}) {
+		fcntl(fd, F_SETFD, FD_CLOEXEC);
+	}
+
+	_pid = fork();
+
+	if (_pid == 0) {
+		// Child: the pipes become its standard input and output
+		dup2(input[0], STDIN_FILENO);
+		dup2(output[1], STDOUT_FILENO);
+		::close(input[0]);
+		::close(input[1]);
+		::close(output[0]);
+		::close(output[1]);
+		execl("/bin/sh", "sh", "-c", command.c_str(), (char*) NULL);
+		_exit(127);
+	}
+
+	::close(input[0]);
+	::close(output[1]);
+
+	if (_pid < 0) {
+		::close(input[1]);
+		::close(output[0]);
+		return false;
+	}
+
+	// Writing to a process that already exited must fail instead of killing this one
+	signal(SIGPIPE, SIG_IGN);
+
+	_inputFd = input[1];
+	_outputFd = output[0];
+#endif
+
+	return true;
+}
+
+void EngineProcess::close() {
+	/*
+	 * Closes the pipes and waits for the process to end, killing it if it doesn't end on its own.
+	 */
+
+	if (!isRunning()) {
+		return;
+	}
+
+#ifdef _WIN32
+	CloseHandle(_input);
+	CloseHandle(_output);
+
+	if (WaitForSingleObject(_process, 1000) != WAIT_OBJECT_0) {
+		TerminateProcess(_process, 1);
+	}
+
+	CloseHandle(_process);
+#else
+	::close(_inputFd);
+	::close(_outputFd);
+
+	// Closing its input makes a well behaved engine quit
+	for (int i = 0; i < 100 && waitpid(_pid, NULL, WNOHANG) == 0; i++) {
+		usleep(10000);
+	}
+
+	if (waitpid(_pid, NULL, WNOHANG) == 0) {
+		kill(_pid, SIGKILL);
+		waitpid(_pid, NULL, 0);
+	}
+#endif
+
+	_buffer.clear();
+	_process = NULL;
+	_input = NULL;
+	_output = NULL;
+	_pid = -1;
+	_inputFd = -1;
+	_outputFd = -1;
+}
+
+bool EngineProcess::isRunning() const {
+	/*
+	 * Returns true if a process was started and not closed yet.
+	 */
+
+	return _process != NULL || _pid > 0;
+}
+
+bool EngineProcess::send(const std::string line) {
+	/*
+	 * Writes a line to the standard input of the process.
+	 * Returns true if successful, false if the process isn't running or closed its input.
+	 */
+
+	std::string data = line + "\n";
+	size_t written = 0;
+
+	if (!isRunning()) {
+		return false;
+	}
+
+	while (written < data.size()) {
+#ifdef _WIN32
+		DWORD count;
+
+		if (!WriteFile(_input, data.data() + written, data.size() - written, &count, NULL)) {
+			return false;
+		}
+#else
+		ssize_t count = write(_inputFd, data.data() + written, data.size() - written);
+
+		if (count <= 0) {
+			return false;
+		}
+#endif
+
+		written += count;
+	}
+
+	return true;
+}
+
+bool EngineProcess::readLine(std::string &line) {
+	/*
+	 * Waits for the next line written by the process to its standard output.
+	 * Returns true if successful, false if the process isn't running or closed its output.
+	 * string line: the line read, without its end of line characters.
+	 */
+
+	char data[4096];
+	size_t end;
+
+	if (!isRunning()) {
+		return false;
+	}
+
+	while ((end = _buffer.find('\n')) == std::string::npos) {
+#ifdef _WIN32
+		DWORD count;
+
+		if (!ReadFile(_output, data, sizeof(data), &count, NULL) || count == 0) {
+			return false;
+		}
+#else
+		ssize_t count = read(_outputFd, data, sizeof(data));
+
+		if (count <= 0) {
+			return false;
+		}
+#endif
+
+		_buffer.append(data, count);
+	}
+
+	line = _buffer.substr(0, end);
+	_buffer.erase(0, end + 1);
+
+	if (!line.empty() && line.back() == '\r') {
+		line.pop_back();
+	}
+
+	return true;
+}
@@ -1,9 +1,22 @@
 #include <Game.h>
+#include <algorithm>
+#include <ctype.h>
+#include <sstream>
+#include <string.h>
+#include "Trace.h"
 
-Game::Game() : _turn(0), _mode(BOTVBOT), _noKillTurns(0), _simulatedTurns(0) {}
+/* Piece letters in FEN, indexed by type, black ones in lowercase */
+static const char FEN_PIECES[] = "bknpqr";
+
+Game::Game() : _turn(0), _mode(BOTVBOT), _noKillTurns(0), _undoCount(0), _key(0), _middlegame(0), _endgame(0), _phase(0) {
+	// Initialize empty cells
+	for (int i = 0; i < 64; i++) {
+		_board[i] = EMPTY;
+	}
+}
 
 /* Parameterized constructor */
-Game::Game(const int mode) : _turn(1), _mode(mode), _noKillTurns(0), _simulatedTurns(0) {
+Game::Game(const int mode) : _turn(1), _mode(mode), _noKillTurns(0), _undoCount(0), _key(0), _middlegame(0), _endgame(0), _phase(0) {
 	// Initialize both white and black players
 	_players[BLACK].init(BLACK);
 	_players[WHITE].init(WHITE);
@@ -12,6 +25,15 @@ Game::Game(const int mode) : _turn(1), _mode(mode), _noKillTurns(0), _simulatedT
 	initState();
 }
 
+/* Copy constructor */
+Game::Game(const Game &other) : Game() {
+	/*
+	 * Creates a simulation-oriented copy, the same as the assignment operator.
+	 */
+
+	*this = other;
+}
+
 Game& Game::operator=(const Game &other) {
 	/*
 	 * Assignment operator to create a simulation-oriented copy.
@@ -21,15 +43,21 @@ Game& Game::operator=(const Game &other) {
 	_turn = other._turn;
 	_mode = BOTVBOT;
 	_noKillTurns = other._noKillTurns;
-	_simulatedTurns = other._simulatedTurns + 1;
+	_undoCount = other._undoCount;
+	_key = other._key;
+	_middlegame = other._middlegame;
+	_endgame = other._endgame;
+	_phase = other._phase;
 
 	_players[0] = other._players[0];
 	_players[1] = other._players[1];
 
-	for (int i = 0; i < 8; i++) {
-		for (int j = 0; j < 8; j++) {
-			_state[i][j] = other._state[i][j];
-		}
+	for (int i = 0; i < 64; i++) {
+		_board[i] = other._board[i];
+	}
+
+	for (int i = 0; i < _undoCount; i++) {
+		_undoStack[i] = other._undoStack[i];
 	}
 
 	return *this;
@@ -45,6 +73,7 @@ void Game::init(const int mode) {
 	_turn = 1;
 	_mode = mode;
 	_noKillTurns = 0;
+	_undoCount = 0;
 
 	// Initialize both white and black players
 	_players[BLACK].init(BLACK);
@@ -59,269 +88,331 @@ void Game::initState() {
 	 * Initializes game state.
 	 */
 
-	// Initialize black pieces
-	for (int i = 0; i < 2; i++) {
-		for (int j = 0; j < 8; j++) {
-			if (i == 1) {
-				_state[i][j].init(Piece::ALIVE, BLACK, PAWN);
-			} else if (j == 0 || j == 7) {
-				_state[i][j].init(Piece::ALIVE, BLACK, ROOK);
-			} else if (j == 1 || j == 6) {
-				_state[i][j].init(Piece::ALIVE, BLACK, KNIGHT);
-			} else if (j == 2 || j == 5) {
-				_state[i][j].init(Piece::ALIVE, BLACK, BISHOP);
-			} else if (j == 3) {
-				_state[i][j].init(Piece::ALIVE, BLACK, QUEEN);
-			} else if (j == 4) {
-				_state[i][j].init(Piece::ALIVE, BLACK, KING);
-			}
-		}
-	}
+	const int backRow[8] = {ROOK, KNIGHT, BISHOP, QUEEN, KING, BISHOP, KNIGHT, ROOK};
 
 	// Initialize empty cells
-	for (int i = 2; i < 6; i++) {
-		for (int j = 0; j < 8; j++) {
-			_state[i][j].init(Piece::DEAD);
-		}
+	for (int i = 0; i < 64; i++) {
+		_board[i] = EMPTY;
 	}
 
-	// Initialize white pieces
-	for (int i = 6; i < 8; i++) {
-		for (int j = 0; j < 8; j++) {
-			if (i == 6) {
-				_state[i][j].init(Piece::ALIVE, WHITE, PAWN);
-			} else if (j == 0 || j == 7) {
-				_state[i][j].init(Piece::ALIVE, WHITE, ROOK);
-			} else if (j == 1 || j == 6) {
-				_state[i][j].init(Piece::ALIVE, WHITE, KNIGHT);
-			} else if (j == 2 || j == 5) {
-				_state[i][j].init(Piece::ALIVE, WHITE, BISHOP);
-			} else if (j == 3) {
-				_state[i][j].init(Piece::ALIVE, WHITE, QUEEN);
-			} else if (j == 4) {
-				_state[i][j].init(Piece::ALIVE, WHITE, KING);
-			}
-		}
+	// Initialize black pieces on the two top rows and white pieces on the two bottom rows
+	for (int j = 0; j < 8; j++) {
+		_board[j] = backRow[j];
+		_players[BLACK].addPiece(backRow[j], j);
+		_board[8 + j] = PAWN;
+		_players[BLACK].addPiece(PAWN, 8 + j);
+		_board[48 + j] = PAWN;
+		_players[WHITE].addPiece(PAWN, 48 + j);
+		_board[56 + j] = backRow[j];
+		_players[WHITE].addPiece(backRow[j], 56 + j);
 	}
+
+	_key = computeKey();
+	computeEvaluation();
 }
 
-bool Game::run() {
+void Game::playTurn(const CompactMove move) {
 	/*
-	 * Runs a chess game until a king is dead or the noKillTurns counter reaches 50.
-	 * Returns true if the game ended successfully, false if the quit button is pressed.
+	 * Plays the current turn, updating player bitboards and game state.
 	 */
 
-	Canvas canvas;
-	Move move(Position(-1, -1), Position(-1, -1));
-	Position click(-1, -1);
-	std::vector<Position> positions;
-	std::chrono::time_point<std::chrono::system_clock> clickTime;
-	bool timing = false;
+	int initial = move.getInitial();
+	int final = move.getFinal();
+	int type = _board[initial];
 
-	// Seed random generator
-	srand(time(0));
+	// Check if a piece was killed and update noKillTurns counter
+	if (_board[final] != EMPTY) {
+		// Update victim player bitboards
+		_players[!(_turn % 2)].killPiece(_board[final], final);
+		_key ^= ZOBRIST.getPieceKey(!(_turn % 2), _board[final], final);
+		updateEvaluation(!(_turn % 2), _board[final], final, -1);
+		_noKillTurns = 0;
+	} else {
+		_noKillTurns++;
+	}
+
+	// Update moving player bitboards
+	_players[_turn % 2].updatePosition(type, initial, final);
+	_key ^= ZOBRIST.getPieceKey(_turn % 2, type, initial) ^ ZOBRIST.getPieceKey(_turn % 2, type, final);
+	updateEvaluation(_turn % 2, type, initial, -1);
+	updateEvaluation(_turn % 2, type, final, 1);
 
-	// Initialize canvas
-	if (!canvas.init()) {
-		std::cout << "Error initializing canvas!" << std::endl;
+	// Update game state
+	_board[final] = type;
+	_board[initial] = EMPTY;
+
+	// Check if a pawn must turn into a queen
+	if (move.isPromotion()) {
+		_players[_turn % 2].killPiece(PAWN, final);
+		_players[_turn % 2].addPiece(QUEEN, final);
+		_board[final] = QUEEN;
+		_key ^= ZOBRIST.getPieceKey(_turn % 2, PAWN, final) ^ ZOBRIST.getPieceKey(_turn % 2, QUEEN, final);
+		updateEvaluation(_turn % 2, PAWN, final, -1);
+		updateEvaluation(_turn % 2, QUEEN, final, 1);
 	}
 
-	// Game main loop
-	do {
-		// Check if "quit" button pressed
-		if (!canvas.processEvents(click)) {
-			canvas.close();
+	_turn++;
+	_key ^= ZOBRIST.getTurnKey();
+}
+
+bool Game::playMoves(const std::string moves) {
+	/*
+	 * Plays a sequence of moves, stopping at the first one that is illegal or would end the game.
+	 * Returns true if every move was played, false if not.
+	 * string moves: space separated moves in "e2e4" notation.
+	 */
+
+	std::istringstream stream(moves);
+	std::string algebraic;
+
+	while (stream >> algebraic) {
+		Move move(algebraic);
+
+		if (move.getInitial() == Position(-1, -1) || !isLegalMove(move) || isGameOver(encodeMove(move))) {
 			return false;
 		}
 
-		// Check if it's a human turn
-		if (_mode == HUMANVHUMAN || (_mode == HUMANVBOT && _turn % 2 == WHITE)) {
-			// Check if there was a mouse click
-			if (click != Position(-1, -1)) {
-				// Process the mouse click
-				if (!processMouseClick(move, click)) {
-					getLegalPositions(positions, move.getInitial());
-					clickTime = std::chrono::system_clock::now();
-					timing = true;
-				}
+		playTurn(encodeMove(move));
+	}
+
+	return true;
+}
+
+bool Game::loadFen(const std::string fen) {
+	/*
+	 * Sets up the game state described in Forsyth-Edwards Notation, keeping the game mode.
+	 * Castling and en passant fields are ignored since the game has neither, and the halfmove clock
+	 * is read as the turns played since the last kill.
+	 * Returns true if successful, false if the notation is malformed (the game is left unchanged then).
+	 * string fen: game state such as "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w - - 0 1",
+	 * where the first row is the black side one. Only the first two fields are required.
+	 */
+
+	std::istringstream stream(fen);
+	std::string placement;
+	std::string active;
+	std::string ignored;
+	int board[64];
+	int kings[2] = {0, 0};
+	int noKillTurns = 0;
+	int fullMoves = 1;
+	int row = 0;
+	int column = 0;
+	int type;
+	const char *letter;
+
+	if (!(stream >> placement >> active) || (active != "w" && active != "b")) {
+		return false;
+	}
+
+	// Optional castling, en passant, halfmove and fullmove fields
+	if (stream >> ignored >> ignored) {
+		stream >> noKillTurns >> fullMoves;
+	}
+
+	for (char c : placement) {
+		if (c == '/') {
+			// Rows must be complete before the next one starts
+			if (column != 8 || row == 7) {
+				return false;
 			}
-		} else {
-			// Make the bot choose a move
-			move = std::get<0>(botChoice());
-		}
 
-		// Check if the move is conformed
-		if (move.getFinal() != Position(-1, -1)) {
-			// Check if the game is over
-			if (isGameOver(move)) {
-				playTurn(move);
-				canvas.displayWinner(_noKillTurns == 50, (_turn - 1) % 2);
-				canvas.close();
-				return true;
+			row++;
+			column = 0;
+		} else if (c >= '1' && c <= '8' && column + c - '0' <= 8) {
+			for (int i = 0; i < c - '0'; i++) {
+				board[8*row + column++] = EMPTY;
 			}
+		} else if ((letter = strchr(FEN_PIECES, tolower(c))) != NULL && *letter != '\0' && column < 8) {
+			type = letter - FEN_PIECES;
 
-			// Perform the move
-			playTurn(move);
-			move = Move(Position(-1, -1), Position(-1, -1));
-		}
+			// Pawns never stand on the rows where they turn into queens
+			if (type == PAWN && (row == 0 || row == 7)) {
+				return false;
+			}
+
+			if (type == KING) {
+				kings[isupper(c) ? WHITE : BLACK]++;
+			}
 
-		// Check timer to erase hints
-		if (timing && (std::chrono::system_clock::now() - clickTime).count() > 500000000) {
-			positions.clear();
-			positions.shrink_to_fit();
-			timing = false;
+			board[8*row + column++] = isupper(c) ? type | 8 : type;
+		} else {
+			return false;
 		}
+	}
 
-		// Update canvas to show game state
-		canvas.update(toString(), move.getInitial(), positions);
+	// Both kings are needed to end the game
+	if (row != 7 || column != 8 || kings[BLACK] != 1 || kings[WHITE] != 1) {
+		return false;
+	}
 
-		click.setBoth(-1, -1);
+	_players[BLACK].init(BLACK);
+	_players[WHITE].init(WHITE);
+
+	for (int i = 0; i < 64; i++) {
+		_board[i] = board[i] == EMPTY ? EMPTY : board[i] & 7;
+
+		if (board[i] != EMPTY) {
+			_players[board[i] >> 3].addPiece(board[i] & 7, i);
+		}
+	}
 
-	} while (true);
+	// Turns start at 1 with white moving, two per full move
+	_turn = 2*std::max(fullMoves, 1) - 1 + (active == "b" ? 1 : 0);
+	_noKillTurns = std::max(0, std::min(noKillTurns, 49));
+	_undoCount = 0;
+	_key = computeKey();
+	computeEvaluation();
+
+	return true;
 }
 
-void Game::playTurn(const Move move) {
+std::string Game::toFen() const {
 	/*
-	 * Plays the current turn, updating player positions and game state.
+	 * Returns the game state in Forsyth-Edwards Notation, see loadFen.
 	 */
 
-	// Check if a piece was killed and update noKillTurns counter
-	if (_state[move.getFinal().getY()][move.getFinal().getX()].isAlive()) {
-		// Update victim player positions
-		_players[!(_turn % 2)].killPiece(move.getFinal());
-		_noKillTurns = 0;
-	} else {
-		_noKillTurns++;
-	}
+	std::string result;
+	int empty = 0;
 
-	// Update moving player positions
-	_players[_turn % 2].updatePosition(move);
+	for (int i = 0; i < 64; i++) {
+		if (_board[i] == EMPTY) {
+			empty++;
+		} else {
+			if (empty > 0) {
+				result += (char) ('0' + empty);
+				empty = 0;
+			}
 
-	// Update game state
-	_state[move.getFinal().getY()][move.getFinal().getX()] = _state[move.getInitial().getY()][move.getInitial().getX()];
-	_state[move.getInitial().getY()][move.getInitial().getX()].setDead();
+			result += (_players[WHITE].getOccupancy() & squareBit(i)) ? (char) toupper(FEN_PIECES[_board[i]]) : FEN_PIECES[_board[i]];
+		}
 
-	// Check if a pawn must turn into a queen
-	if (_state[move.getFinal().getY()][move.getFinal().getX()].getType() == PAWN &&
-			(move.getFinal().getY() == 0 || move.getFinal().getY() == 7)) {
-		_state[move.getFinal().getY()][move.getFinal().getX()].toQueen();
+		// End of a row
+		if (i % 8 == 7) {
+			if (empty > 0) {
+				result += (char) ('0' + empty);
+				empty = 0;
+			}
+
+			if (i < 63) {
+				result += '/';
+			}
+		}
 	}
 
-	_turn++;
+	result += _turn % 2 == WHITE ? " w - - " : " b - - ";
+	result += std::to_string(_noKillTurns) + " " + std::to_string((_turn + 1)/2);
+
+	return result;
 }
 
-bool Game::processMouseClick(Move &move, Position click) const {
+void Game::makeMove(const CompactMove move) {
 	/*
-	 * Processes a mouse click during a human turn to check validness.
+	 * Plays a simulated move, saving what is needed to take it back with unmakeMove.
+	 * Move move: move to be played.
 	 */
 
-	// Re-scale click from window to board size
-	click.scale(Canvas::CANVAS_WIDTH, 8, Canvas::CANVAS_HEIGHT, 8);
+	Undo &undo = _undoStack[_undoCount++];
 
-	if (_state[click.getY()][click.getX()].isAlive() && _state[click.getY()][click.getX()].getColor() == _turn % 2) {
-		// Active player clicked one of his alive pieces
-		move.setInitial(click);
-	} else if (move.getInitial() != Position(-1, -1)) {
-		if (isLegalMove(Move(move.getInitial(), click))) {
-			// Active player clicked on a legal final position
-			move.setFinal(click);
-		} else {
-			// Incorrect final position
-			return false;
-		}
-	}
+	undo.initial = move.getInitial();
+	undo.final = move.getFinal();
+	undo.captured = _board[undo.final];
+	undo.promotion = move.isPromotion();
+	undo.noKillTurns = _noKillTurns;
+	undo.key = _key;
+	undo.middlegame = _middlegame;
+	undo.endgame = _endgame;
+	undo.phase = _phase;
 
-	return true;
+	playTurn(move);
 }
 
-std::tuple<Move, int> Game::botChoice() const {
+void Game::unmakeMove() {
 	/*
-	 * Chooses the best move to take depending on the score of every single move.
-	 * Returns a tuple containing the chosen move and the score associated with it.
+	 * Takes back the last move played with makeMove, restoring the previous game state.
 	 */
 
-	std::vector<Position> positions;
-	std::vector<Move> bestMoves;
-	Game simulation;
-	int score;
-	int maxScore = INT_MIN;
-
-	// Iterate through all active player current positions
-	for (auto &initial : _players[_turn % 2].getPositions()) {
-		// Get all the legal positions for the specific piece
-		getLegalPositions(positions, initial);
-
-		//Iterate through all the legal positions of the piece
-		for (unsigned int i = 0; i < positions.size(); i++) {
-			if (_state[positions[i].getY()][positions[i].getX()].isAlive()) {
-				// Update score if an enemy is killed
-				score = _state[positions[i].getY()][positions[i].getX()].getValue();
-			} else {
-				score = 0;
-			}
+	const Undo &undo = _undoStack[--_undoCount];
 
-			// Start a simulation if maximum simulated turns not reached
-			if (_simulatedTurns < MAX_SIMULATED_TURNS && !isGameOver(Move(initial, positions[i]))) {
-				// Create a copy of the game for simulation purposes
-				simulation = *this;
+	_turn--;
 
-				// Perform the move being evaluated
-				simulation.playTurn(Move(initial, positions[i]));
+	int type = _board[undo.final];
 
-				// Update score with simulation results
-				score -= std::get<1>(simulation.botChoice());
-			}
+	// Turn the queen back into a pawn if the move promoted it
+	if (undo.promotion) {
+		_players[_turn % 2].killPiece(QUEEN, undo.final);
+		_players[_turn % 2].addPiece(PAWN, undo.final);
+		type = PAWN;
+	}
 
-			// Update list of best moves and the best score achieved
-			if (score > maxScore) {
-				bestMoves.clear();
-				bestMoves.push_back(Move(initial, positions[i]));
-				maxScore = score;
-			} else if (score == maxScore) {
-				bestMoves.push_back(Move(initial, positions[i]));
-			}
-		}
+	// Move the piece back to its initial cell
+	_players[_turn % 2].updatePosition(type, undo.final, undo.initial);
+	_board[undo.initial] = type;
+	_board[undo.final] = undo.captured;
 
-		positions.clear();
+	// Revive the killed piece if there was one
+	if (undo.captured != EMPTY) {
+		_players[!(_turn % 2)].addPiece(undo.captured, undo.final);
 	}
 
-	// Return a random move from the best moves list
-	return {bestMoves[rand() % bestMoves.size()], maxScore};
+	_noKillTurns = undo.noKillTurns;
+	_key = undo.key;
+	_middlegame = undo.middlegame;
+	_endgame = undo.endgame;
+	_phase = undo.phase;
 }
 
-bool Game::isGameOver(const Move move) const {
+bool Game::isGameOver(const CompactMove move) const {
 	/*
 	 * Checks if the move would end the game by killing the king or by reaching 50 turns without a kill.
 	 * Returns true if the game would end, false if not.
 	 * Move move: move to be checked.
 	 */
 
-	return (_state[move.getFinal().getY()][move.getFinal().getX()].isAlive() &&
-			_state[move.getFinal().getY()][move.getFinal().getX()].getType() == KING) ||
-			(!_state[move.getFinal().getY()][move.getFinal().getX()].isAlive() && _noKillTurns == 49);
+	int final = _board[move.getFinal()];
+
+	return final == KING || (final == EMPTY && _noKillTurns == 49);
 }
 
 bool Game::isLegalMove(const Move move) const {
 	/*
-	 * Checks if a move is legal.
+	 * Checks if a move is legal: the active player moves one of their own pieces to one of its targets.
 	 * Returns true if the move is legal, false if not.
 	 * Move move: move to be checked.
 	 */
 
-	std::vector<Position> positions;
+	Position initial = move.getInitial();
+	Position final = move.getFinal();
 
-	// Get list of legal final positions
-	getLegalPositions(positions, move.getInitial());
+	// Positions outside the board are never legal
+	if (initial.getX() < 0 || initial.getX() > 7 || initial.getY() < 0 || initial.getY() > 7 ||
+			final.getX() < 0 || final.getX() > 7 || final.getY() < 0 || final.getY() > 7) {
+		return false;
+	}
 
-	// Iterate through the legal positions to find the move being checked
-	for (unsigned int i = 0; i < positions.size(); i++) {
-		if (move.getFinal() == positions[i]) {
-			// The move being checked was found
-			return true;
-		}
+	// Only the active player's pieces can move
+	if ((_players[_turn % 2].getOccupancy() & squareBit(toSquare(initial))) == 0) {
+		return false;
+	}
+
+	return (getLegalTargets(toSquare(initial)) & squareBit(toSquare(final))) != 0;
+}
+
+CompactMove Game::encodeMove(const Move move) const {
+	/*
+	 * Packs a move coming from the UI for the game and the search, flagging pawns that turn into queens.
+	 * Returns the packed move.
+	 * Move move: move inside the board.
+	 */
+
+	int initial = toSquare(move.getInitial());
+	int final = toSquare(move.getFinal());
+
+	if (_board[initial] == PAWN && (squareBit(final) & (ROW_0 | ROW_7))) {
+		return CompactMove(initial, final, CompactMove::PROMOTION);
 	}
 
-	return false;
+	return CompactMove(initial, final);
 }
 
 void Game::getLegalPositions(std::vector<Position> &positions, const Position initial) const {
@@ -331,82 +422,247 @@ void Game::getLegalPositions(std::vector<Position> &positions, const Position in
 	 * Position initial: piece initial position.
 	 */
 
-	std::vector<Position> directions;
+	Bitboard targets = getLegalTargets(toSquare(initial));
 
-	// Get a list of legal directions the piece could take
-	_state[initial.getY()][initial.getX()].getDirections(directions);
+	// Convert every legal final cell into a position
+	while (targets) {
+		positions.push_back(toPosition(popLowestSquare(targets)));
+	}
+}
 
-	// Iterate through the legal directions
-	for (unsigned int i = 0; i < directions.size(); i++) {
-		if (_state[initial.getY()][initial.getX()].getType() == PAWN) {
-			// Pawns are treated differently due to their unique movement patterns
-			followPawnDirection(positions, initial, directions[i]);
+Bitboard Game::getLegalTargets(const int square) const {
+	/*
+	 * Gets the bitboard of all legal final cells given an initial one.
+	 * Returns an empty bitboard if there is no piece in the cell.
+	 * int square: piece initial cell index.
+	 */
+
+	Bitboard occupancy = _players[BLACK].getOccupancy() | _players[WHITE].getOccupancy();
+	bool color = (_players[WHITE].getOccupancy() & squareBit(square)) != 0;
+	int type = _board[square];
+	Bitboard targets;
+
+	if (type == PAWN) {
+		// Pawns move straight to empty cells (twice on their first move) and kill diagonally
+		if (color == BLACK) {
+			targets = (squareBit(square) << 8) & ~occupancy;
+			targets |= ((targets & (ROW_1 << 8)) << 8) & ~occupancy;
 		} else {
-			followDirection(positions, initial, directions[i]);
+			targets = (squareBit(square) >> 8) & ~occupancy;
+			targets |= ((targets & (ROW_6 >> 8)) >> 8) & ~occupancy;
 		}
+
+		return targets | (pawnAttacks(color, square) & _players[!color].getOccupancy());
+	} else if (type == KNIGHT) {
+		targets = knightAttacks(square);
+	} else if (type == KING) {
+		targets = kingAttacks(square);
+	} else if (type == BISHOP) {
+		targets = bishopAttacks(square, occupancy);
+	} else if (type == ROOK) {
+		targets = rookAttacks(square, occupancy);
+	} else if (type == QUEEN) {
+		targets = queenAttacks(square, occupancy);
+	} else {
+		return 0;
+	}
+
+	// Pieces can't kill their own allies
+	return targets & ~_players[color].getOccupancy();
+}
+
+void Game::generateMoves(MoveList &moves) const {
+	/*
+	 * Adds every legal move of the active player to the list, piece by piece from the lowest cell.
+	 * MoveList moves: list where legal moves will be added to.
+	 */
+
+	TRACE_TOTAL(Trace::MOVE_GENERATION);
+
+	Bitboard pieces = _players[_turn % 2].getOccupancy();
+	int initial;
+
+	while (pieces) {
+		initial = popLowestSquare(pieces);
+		addMoves(moves, initial, getLegalTargets(initial));
 	}
 }
 
-void Game::followPawnDirection(std::vector<Position> &positions, const Position initial, const Position direction) const {
+void Game::generateKills(MoveList &moves) const {
 	/*
-	 * Follows a pawn direction and checks its legality.
-	 * vector<Position> positions: vector where legal positions will be added to.
-	 * Position initial: pawn initial position.
-	 * Position direction: direction being followed.
+	 * Adds every legal move of the active player that kills an enemy piece to the list.
+	 * MoveList moves: list where killing moves will be added to.
 	 */
-	if (initial.getY() + direction.getY() >= 0 && initial.getY() + direction.getY() < 8 &&
-			initial.getX() + direction.getX() >= 0 && initial.getX() + direction.getX() < 8) {
-		if (direction.getX() == 0) {
-			// Straight move
-			if (!_state[initial.getY() + direction.getY()][initial.getX()].isAlive()) {
-				// Front cell is empty
-				positions.push_back(Position(initial.getX(), initial.getY() + direction.getY()));
-				if (!_state[initial.getY() + direction.getY()*2][initial.getX()].isAlive() &&
-						((_state[initial.getY()][initial.getX()].getColor() == BLACK && initial.getY() == 1) ||
-						(_state[initial.getY()][initial.getX()].getColor() == WHITE && initial.getY() == 6))) {
-					// It's the first move the pawn would take and the second front cell is empty
-					positions.push_back(Position(initial.getX(), initial.getY() + direction.getY()*2));
-				}
+
+	TRACE_TOTAL(Trace::MOVE_GENERATION);
+
+	Bitboard pieces = _players[_turn % 2].getOccupancy();
+	Bitboard enemies = _players[!(_turn % 2)].getOccupancy();
+	int initial;
+
+	while (pieces) {
+		initial = popLowestSquare(pieces);
+		addMoves(moves, initial, getLegalTargets(initial) & enemies);
+	}
+}
+
+void Game::addMoves(MoveList &moves, const int initial, Bitboard targets) const {
+	/*
+	 * Adds the moves of the piece on the initial cell to every target cell, flagging pawns that turn into queens.
+	 * MoveList moves: list where moves will be added to.
+	 * int initial: cell of the moving piece.
+	 * Bitboard targets: final cells of the moves.
+	 */
+
+	Bitboard promotions = _board[initial] == PAWN ? targets & (ROW_0 | ROW_7) : 0;
+
+	targets &= ~promotions;
+
+	while (targets) {
+		moves.add(CompactMove(initial, popLowestSquare(targets)));
+	}
+
+	while (promotions) {
+		moves.add(CompactMove(initial, popLowestSquare(promotions), CompactMove::PROMOTION));
+	}
+}
+
+Piece Game::getPiece(const Position position) const {
+	/*
+	 * Returns the piece standing on the given position (a dead piece if the cell is empty).
+	 */
+
+	int square = toSquare(position);
+
+	if (_board[square] == EMPTY) {
+		return Piece();
+	}
+
+	return Piece(Piece::ALIVE, (_players[WHITE].getOccupancy() & squareBit(square)) != 0, _board[square]);
+}
+
+int Game::getMode() const {
+	/*
+	 * Returns the game mode (BOTVBOT, HUMANVBOT, HUMANVHUMAN).
+	 */
+
+	return _mode;
+}
+
+int Game::getPieceType(const int square) const {
+	/*
+	 * Returns the type of the piece standing on the cell, or EMPTY if there is none.
+	 */
+
+	return _board[square];
+}
+
+Bitboard Game::getOccupancy(const bool color) const {
+	/*
+	 * Returns bitboard of all the pieces of the given color.
+	 */
+
+	return _players[color].getOccupancy();
+}
+
+bool Game::getActiveColor() const {
+	/*
+	 * Returns the color of the player whose turn it is.
+	 */
+
+	return _turn % 2;
+}
+
+int Game::getNoKillTurns() const {
+	/*
+	 * Returns the number of turns played since the last kill.
+	 */
+
+	return _noKillTurns;
+}
+
+unsigned long long Game::getKey() const {
+	/*
+	 * Returns the Zobrist key of the game state, updated incrementally on every move.
+	 */
+
+	return _key;
+}
+
+unsigned long long Game::computeKey() const {
+	/*
+	 * Computes the Zobrist key of the game state from scratch.
+	 */
+
+	unsigned long long key = 0;
+	Bitboard pieces;
+
+	for (int color = 0; color < 2; color++) {
+		for (int type = 0; type < 6; type++) {
+			pieces = _players[color].getPieces(type);
+
+			while (pieces) {
+				key ^= ZOBRIST.getPieceKey(color, type, popLowestSquare(pieces));
 			}
-		} else if (_state[initial.getY() + direction.getY()][initial.getX() + direction.getX()].isAlive() &&
-				_state[initial.getY() + direction.getY()][initial.getX() + direction.getX()].getColor() != _turn % 2) {
-			// Diagonal move
-			// There is an enemy piece at the final position
-			positions.push_back(Position(initial.getX() + direction.getX(), initial.getY() + direction.getY()));
 		}
 	}
+
+	if (_turn % 2 == WHITE) {
+		key ^= ZOBRIST.getTurnKey();
+	}
+
+	return key;
 }
 
-void Game::followDirection(std::vector<Position> &positions, const Position initial, const Position direction) const {
+void Game::updateEvaluation(const bool color, const int type, const int square, const int sign) {
 	/*
-	 * Follows a piece direction and checks its legality.
-	 * vector<Position> positions: vector where legal positions will be added to.
-	 * Position initial: piece initial position.
-	 * Position direction: direction being followed.
+	 * Adds or removes the piece-square score of a piece, keeping the evaluation up to date move by move.
+	 * bool color: color of the piece.
+	 * int type: type of the piece.
+	 * int square: cell of the piece.
+	 * int sign: 1 if the piece is placed on the cell, -1 if it leaves it.
 	 */
 
-	int step = 1;
+	_middlegame += sign*EVALUATION.getMiddlegame(color, type, square);
+	_endgame += sign*EVALUATION.getEndgame(color, type, square);
+	_phase += sign*EVALUATION.getPhase(type);
+}
 
-	// Kings and knights will loop only once, the rest will loop until a piece is found or the board ends
-	do {
-		if (initial.getY() + direction.getY()*step < 0 || initial.getY() + direction.getY()*step >= 8 ||
-				initial.getX() + direction.getX()*step < 0 || initial.getX() + direction.getX()*step >= 8) {
-			break;
-		}
-		if (_state[initial.getY() + direction.getY()*step][initial.getX() + direction.getX()*step].isAlive()) {
-			// A piece is found on the way
-			if (_state[initial.getY() + direction.getY()*step][initial.getX() + direction.getX()*step].getColor() != _turn % 2) {
-				// The piece found is an enemy piece
-				positions.push_back(Position(initial.getX() + direction.getX()*step, initial.getY() + direction.getY()*step));
-			}
+void Game::computeEvaluation() {
+	/*
+	 * Computes the evaluation terms from scratch, from the pieces on the board.
+	 */
+
+	Bitboard pieces;
+	int square;
 
-			break;
+	_middlegame = 0;
+	_endgame = 0;
+	_phase = 0;
+
+	for (int color = 0; color < 2; color++) {
+		for (int type = 0; type < 6; type++) {
+			pieces = _players[color].getPieces(type);
+
+			while (pieces) {
+				square = popLowestSquare(pieces);
+				updateEvaluation(color, type, square, 1);
+			}
 		}
+	}
+}
+
+int Game::evaluate() const {
+	/*
+	 * Evaluates the game state from the active player side, blending middlegame and endgame scores
+	 * by how many pieces are left (queens turned from pawns may push the phase past its maximum).
+	 * Returns the score, positive if the active player is better.
+	 */
 
-		positions.push_back(Position(initial.getX() + direction.getX()*step, initial.getY() + direction.getY()*step));
+	int phase = _phase < Evaluation::MAX_PHASE ? _phase : Evaluation::MAX_PHASE;
+	int score = (_middlegame*phase + _endgame*(Evaluation::MAX_PHASE - phase)) / Evaluation::MAX_PHASE;
 
-		step++;
-	} while (_state[initial.getY()][initial.getX()].getType() != KING && _state[initial.getY()][initial.getX()].getType() != KNIGHT);
+	return _turn % 2 == WHITE ? score : -score;
 }
 
 std::string Game::toString() const {
@@ -419,10 +675,8 @@ std::string Game::toString() const {
 	result = "";
 
 	// Add every piece string in the game state
-	for (int i = 0; i < 8; i++) {
-		for (int j = 0; j < 8; j++) {
-			result += _state[i][j].toString();
-		}
+	for (int i = 0; i < 64; i++) {
+		result += getPiece(toPosition(i)).toString();
 	}
 
 	return result;
@@ -0,0 +1,231 @@
+#include "Gui.h"
+
+Gui::Gui() : _thinking(false), _choice(Move(Position(-1, -1), Position(-1, -1)), 0), _ponder(false), _pondering(false),
+		_ponderMove(NO_MOVE) {}
+
+/* Parameterized constructor */
+Gui::Gui(const bool ponder) : _thinking(false), _choice(Move(Position(-1, -1), Position(-1, -1)), 0), _ponder(ponder),
+		_pondering(false), _ponderMove(NO_MOVE) {}
+
+bool Gui::run(Game &game, Search &search) {
+	/*
+	 * Runs a chess game until a king is dead or the noKillTurns counter reaches 50.
+	 * Returns true if the game ended successfully, false if the quit button is pressed.
+	 * Game game: game to be played.
+	 * Search search: search used by the bots to choose their moves.
+	 */
+
+	Move move(Position(-1, -1), Position(-1, -1));
+	CompactMove played;
+	Position click(-1, -1);
+	std::vector<Position> positions;
+	std::chrono::time_point<std::chrono::steady_clock> clickTime;
+	bool timing = false;
+	bool humanTurn;
+	int timeout;
+
+	// Seed random generator
+	srand(time(0));
+
+	// Initialize canvas
+	if (!_canvas.init()) {
+		std::cout << "Error initializing canvas!" << std::endl;
+	}
+
+	// Draw the initial board
+	_canvas.update(game, move.getInitial(), positions);
+
+	// Game main loop
+	do {
+		humanTurn = game.getMode() == Game::HUMANVHUMAN || (game.getMode() == Game::HUMANVBOT && game.getActiveColor() == WHITE);
+
+		// Humans sleep until an event arrives or the hints have to be erased,
+		// bots until their search ends or its progress has to be shown
+		if (!humanTurn) {
+			timeout = PROGRESS_MILLISECONDS;
+		} else if (timing) {
+			timeout = HINT_MILLISECONDS - std::chrono::duration_cast<std::chrono::milliseconds>(
+					std::chrono::steady_clock::now() - clickTime).count();
+			timeout = timeout > 0 ? timeout : 0;
+		} else {
+			timeout = -1;
+		}
+
+		// Check if "quit" button pressed
+		if (!_canvas.processEvents(click, timeout)) {
+			stopThinking(search);
+			_canvas.close();
+			return false;
+		}
+
+		// Check if it's a human turn
+		if (humanTurn) {
+			// Check if there was a mouse click
+			if (click != Position(-1, -1)) {
+				// Process the mouse click
+				if (!processMouseClick(game, move, click)) {
+					game.getLegalPositions(positions, move.getInitial());
+					clickTime = std::chrono::steady_clock::now();
+					timing = true;
+				}
+			}
+		} else if (!_searchThread.joinable()) {
+			// Make the bot choose a move on its own thread, so that the window keeps processing events
+			_thinking = true;
+			search.clearStop();
+			_searchThread = std::thread(&Gui::think, this, game, std::ref(search));
+		} else if (!_thinking) {
+			// The bot has chosen its move
+			_searchThread.join();
+			move = std::get<0>(_choice);
+			_canvas.setStatus("");
+		} else {
+			_canvas.setStatus(toProgress(search));
+		}
+
+		// Check if the move is conformed
+		if (move.getFinal() != Position(-1, -1)) {
+			played = game.encodeMove(move);
+
+			// Check if the game is over
+			if (game.isGameOver(played)) {
+				stopThinking(search);
+				game.playTurn(played);
+				_canvas.update(game, Position(-1, -1), std::vector<Position>());
+				_canvas.displayWinner(game.getNoKillTurns() == 50, !game.getActiveColor());
+				_canvas.close();
+				return true;
+			}
+
+			// A pondering bot keeps its search if the human played the predicted move, and drops it if not
+			if (_pondering) {
+				if (played == _ponderMove) {
+					search.getTimeManager().ponderHit();
+					_pondering = false;
+				} else {
+					stopThinking(search);
+				}
+			}
+
+			// Perform the move
+			game.playTurn(played);
+			move = Move(Position(-1, -1), Position(-1, -1));
+
+			// Let the bot think while the human chooses a move
+			if (_ponder && game.getMode() == Game::HUMANVBOT && game.getActiveColor() == WHITE) {
+				startPondering(game, search);
+			}
+		}
+
+		// Check timer to erase hints
+		if (timing && std::chrono::steady_clock::now() - clickTime >= std::chrono::milliseconds(HINT_MILLISECONDS)) {
+			positions.clear();
+			positions.shrink_to_fit();
+			timing = false;
+		}
+
+		// Update canvas to show game state, only changed squares are drawn
+		_canvas.update(game, move.getInitial(), positions);
+
+		click.setBoth(-1, -1);
+
+	} while (true);
+}
+
+void Gui::think(const Game &game, Search &search) {
+	/*
+	 * Body of the search thread: chooses the bot move and wakes up the main loop.
+	 * Game game: copy of the game owned by the thread, the main loop may change its own meanwhile.
+	 */
+
+	_choice = search.botChoice(game);
+	_thinking = false;
+	_canvas.wake();
+}
+
+void Gui::stopThinking(Search &search) {
+	/*
+	 * Stops the bot search, if any, and waits until its thread ends.
+	 * A pondering search is dropped along with its choice.
+	 */
+
+	if (_searchThread.joinable()) {
+		search.stop();
+		_searchThread.join();
+	}
+
+	if (_pondering) {
+		search.getTimeManager().setPondering(false);
+		_pondering = false;
+	}
+}
+
+void Gui::startPondering(const Game &game, Search &search) {
+	/*
+	 * Starts the bot search of the game state reached after the human move predicted by the last search,
+	 * as stored in the transposition table, while the human is still choosing a move.
+	 * Nothing is searched if there is no prediction.
+	 * Game game: game whose active player is the human.
+	 */
+
+	Game ponderGame = game;
+	CompactMove predicted;
+	int depth;
+	int score;
+	int bound;
+
+	if (!search.getTable().probe(game.getKey(), depth, score, bound, predicted) || predicted.isNone() ||
+			!game.isLegalMove(predicted.toMove()) || game.isGameOver(predicted)) {
+		return;
+	}
+
+	ponderGame.playTurn(predicted);
+
+	_ponderMove = predicted;
+	_pondering = true;
+	search.getTimeManager().setPondering(true);
+
+	_thinking = true;
+	search.clearStop();
+	_searchThread = std::thread(&Gui::think, this, ponderGame, std::ref(search));
+}
+
+std::string Gui::toProgress(const Search &search) const {
+	/*
+	 * Returns the progress of the running bot search: depth, best move and score of the last
+	 * completed iteration, and the nodes visited so far.
+	 */
+
+	std::string result = "thinking";
+
+	if (search.getCurrentDepth() > 0) {
+		result += ": depth " + std::to_string(search.getCurrentDepth()) + ", best " + search.getCurrentMove().toAlgebraic() +
+				" (" + std::to_string(search.getCurrentScore()) + ")";
+	}
+
+	return result + ", " + std::to_string(search.getCurrentNodes()) + " nodes";
+}
+
+bool Gui::processMouseClick(const Game &game, Move &move, Position click) const {
+	/*
+	 * Processes a mouse click during a human turn to check validness.
+	 */
+
+	// Re-scale click from window to board size
+	click.scale(Canvas::CANVAS_WIDTH, 8, Canvas::CANVAS_HEIGHT, 8);
+
+	if (game.getOccupancy(game.getActiveColor()) & squareBit(toSquare(click))) {
+		// Active player clicked one of his alive pieces
+		move.setInitial(click);
+	} else if (move.getInitial() != Position(-1, -1)) {
+		if (game.isLegalMove(Move(move.getInitial(), click))) {
+			// Active player clicked on a legal final position
+			move.setFinal(click);
+		} else {
+			// Incorrect final position
+			return false;
+		}
+	}
+
+	return true;
+}
@@ -0,0 +1,133 @@
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile() : _data(NULL), _size(0), _file(NULL), _mapping(NULL) {}
+
+MappedFile::~MappedFile() {
+	close();
+}
+
+bool MappedFile::open(const std::string path) {
+	/*
+	 * Maps a whole file into memory for reading, closing the file mapped before if any.
+	 * Returns true if successful, false if the file can't be opened or is empty.
+	 * string path: file to be mapped.
+	 */
+
+	close();
+
+#ifdef _WIN32
+	HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	LARGE_INTEGER size;
+
+	if (file == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+
+	if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+		CloseHandle(file);
+		return false;
+	}
+
+	HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+
+	if (mapping == NULL) {
+		CloseHandle(file);
+		return false;
+	}
+
+	void *data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+
+	if (data == NULL) {
+		CloseHandle(mapping);
+		CloseHandle(file);
+		return false;
+	}
+
+	_file = file;
+	_mapping = mapping;
+	_size = size.QuadPart;
+#else
+	int file = ::open(path.c_str(), O_RDONLY);
+	struct stat status;
+
+	if (file < 0) {
+		return false;
+	}
+
+	if (fstat(file, &status) < 0 || status.st_size == 0) {
+		::close(file);
+		return false;
+	}
+
+	void *data = mmap(NULL, status.st_size, PROT_READ, MAP_SHARED, file, 0);
+
+	// The mapping keeps the file contents reachable on its own
+	::close(file);
+
+	if (data == MAP_FAILED) {
+		return false;
+	}
+
+	_size = status.st_size;
+#endif
+
+	_data = (const unsigned char*) data;
+
+	return true;
+}
+
+void MappedFile::close() {
+	/*
+	 * Unmaps the file, if any.
+	 */
+
+	if (_data == NULL) {
+		return;
+	}
+
+#ifdef _WIN32
+	UnmapViewOfFile(_data);
+	CloseHandle(_mapping);
+	CloseHandle(_file);
+#else
+	munmap((void*) _data, _size);
+#endif
+
+	_data = NULL;
+	_size = 0;
+	_file = NULL;
+	_mapping = NULL;
+}
+
+bool MappedFile::isOpen() const {
+	/*
+	 * Returns true if a file is mapped.
+	 */
+
+	return _data != NULL;
+}
+
+const unsigned char* MappedFile::getData() const {
+	/*
+	 * Returns the first byte of the mapped file, NULL if none.
+	 */
+
+	return _data;
+}
+
+size_t MappedFile::getSize() const {
+	/*
+	 * Returns the size of the mapped file in bytes, 0 if none.
+	 */
+
+	return _size;
+}
@@ -0,0 +1,227 @@
+#include "Match.h"
+#include <atomic>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+Match::Match(const EngineOptions &first, const EngineOptions &second) : _sprtEnabled(true) {
+	_options[0] = first;
+	_options[1] = second;
+}
+
+int Match::loadOpenings(std::istream &input) {
+	/*
+	 * Adds the opening game states of a file, one FEN per line (EPD lines work too), skipping
+	 * lines that can't be read.
+	 * Returns the number of openings added.
+	 */
+
+	std::string line;
+	Game game(Game::BOTVBOT);
+	int count = 0;
+
+	while (std::getline(input, line)) {
+		if (game.loadFen(line)) {
+			_openings.push_back(game.toFen());
+			count++;
+		}
+	}
+
+	return count;
+}
+
+void Match::generateOpenings(const int count, const int plies) {
+	/*
+	 * Adds openings made of random moves played from the initial game state.
+	 * int count: number of openings.
+	 * int plies: random turns played in every opening.
+	 */
+
+	MoveList moves;
+	CompactMove move;
+
+	for (int i = 0; i < count; i++) {
+		Game game(Game::BOTVBOT);
+
+		for (int ply = 0; ply < plies; ply++) {
+			moves.clear();
+			game.generateMoves(moves);
+			move = moves.get(rand() % moves.size());
+
+			// Openings never end the game
+			if (game.isGameOver(move)) {
+				ply--;
+				continue;
+			}
+
+			game.playTurn(move);
+		}
+
+		_openings.push_back(game.toFen());
+	}
+}
+
+void Match::setSprt(const Sprt &sprt, const bool enabled) {
+	/*
+	 * Sets the test deciding when the match ends before playing every game.
+	 * bool enabled: false to always play every game, only reporting the test.
+	 */
+
+	_sprt = sprt;
+	_sprtEnabled = enabled;
+}
+
+int Match::playGame(Engine &white, Engine &black, const std::string fen) const {
+	/*
+	 * Plays a game until a king is killed, 50 turns pass without a kill or the active player has no moves.
+	 * An engine giving no legal move loses the game.
+	 * Returns the color of the winner, or DRAW.
+	 * string fen: game state the game starts from.
+	 */
+
+	Engine *engines[2] = {&black, &white};
+	Game game(Game::BOTVBOT);
+	std::vector<CompactMove> moves;
+	MoveList legalMoves;
+	CompactMove move;
+	bool color;
+
+	game.loadFen(fen);
+	white.newGame();
+	black.newGame();
+
+	while (true) {
+		legalMoves.clear();
+		game.generateMoves(legalMoves);
+
+		if (legalMoves.size() == 0) {
+			return DRAW;
+		}
+
+		color = game.getActiveColor();
+		move = engines[color]->choose(game, fen, moves);
+
+		if (move.isNone()) {
+			return !color;
+		}
+
+		if (game.isGameOver(move)) {
+			return game.getPieceType(move.getFinal()) == KING ? color : DRAW;
+		}
+
+		game.playTurn(move);
+		moves.push_back(move);
+	}
+}
+
+int Match::run(const int games, const int concurrency, std::ostream &output) {
+	/*
+	 * Plays games between both engines, several of them at the same time, until every game is played
+	 * or the test is conclusive. Every opening is played twice, once with each engine as white.
+	 * A line is printed per game with the results so far, then a summary.
+	 * Returns Sprt::ACCEPT_H1 if the first engine is stronger, Sprt::ACCEPT_H0 if it isn't,
+	 * Sprt::CONTINUE if the test is inconclusive, or -1 if an engine can't be started.
+	 * int games: maximum number of games.
+	 * int concurrency: games played at the same time, each one by its own pair of engines.
+	 * ostream output: where the report is printed.
+	 */
+
+	std::vector<std::unique_ptr<Engine>> engines;
+	std::vector<std::thread> threads;
+	std::atomic<int> next(0);
+	std::atomic<bool> stop(false);
+	std::mutex resultsMutex;
+	int results[3] = {0, 0, 0};
+	int played = 0;
+	int decided = 0;
+	int state = Sprt::CONTINUE;
+
+	if (_openings.empty()) {
+		generateOpenings((games + 1)/2, DEFAULT_OPENING_PLIES);
+	}
+
+	// Engines are started one by one, before any game
+	for (int i = 0; i < 2*concurrency; i++) {
+		engines.push_back(std::unique_ptr<Engine>(new Engine(_options[i % 2])));
+
+		if (!engines.back()->start()) {
+			output << "Error starting engine " << _options[i % 2].name << std::endl;
+			return -1;
+		}
+	}
+
+	auto work = [&](Engine &first, Engine &second) {
+		int index;
+		int winner;
+		int result;
+
+		while (!stop && (index = next++) < games) {
+			// Both games of an opening are played one after the other, swapping colors
+			const std::string &fen = _openings[(index/2) % _openings.size()];
+			bool firstWhite = index % 2 == 0;
+
+			winner = firstWhite ? playGame(first, second, fen) : playGame(second, first, fen);
+			result = winner == DRAW ? 1 : (winner == WHITE) == firstWhite ? 0 : 2;
+
+			std::lock_guard<std::mutex> lock(resultsMutex);
+
+			results[result]++;
+			played++;
+
+			output << "Game " << std::setw(5) << index + 1 << ": " << std::left << std::setw(10) <<
+					(result == 1 ? "draw" : _options[result == 0 ? 0 : 1].name + " wins") << std::right <<
+					"  +" << results[0] << " =" << results[1] << " -" << results[2] <<
+					std::fixed << std::setprecision(2) << "  LLR " << _sprt.getLogLikelihoodRatio(results[0], results[1], results[2]) <<
+					" [" << _sprt.getLowerBound() << ", " << _sprt.getUpperBound() << "]" << std::endl;
+
+			// Games that were already being played when the test concluded can't change its decision
+			if (!stop) {
+				state = _sprt.getState(results[0], results[1], results[2]);
+
+				if (_sprtEnabled && state != Sprt::CONTINUE) {
+					stop = true;
+					decided = played;
+				}
+			}
+		}
+	};
+
+	for (int i = 1; i < concurrency; i++) {
+		threads.push_back(std::thread(work, std::ref(*engines[2*i]), std::ref(*engines[2*i + 1])));
+	}
+
+	work(*engines[0], *engines[1]);
+
+	for (auto &thread : threads) {
+		thread.join();
+	}
+
+	double score = played > 0 ? (results[0] + 0.5*results[1])/played : 0.5;
+
+	output << _options[0].name << " vs " << _options[1].name << ": " << played << " games, +" << results[0] <<
+			" =" << results[1] << " -" << results[2] << ", score " << std::fixed << std::setprecision(1) << 100*score << "%" << std::endl;
+
+	if (score > 0 && score < 1) {
+		double error = Sprt::getEloError(results[0], results[1], results[2]);
+
+		output << "Elo difference: " << Sprt::toElo(score);
+
+		if (error > 0) {
+			output << " +/- " << error;
+		}
+
+		output << std::endl;
+	}
+
+	output << "SPRT: " << (state == Sprt::ACCEPT_H1 ? "H1 accepted" : state == Sprt::ACCEPT_H0 ? "H0 accepted" : "inconclusive") <<
+			std::setprecision(2) << " (LLR " << _sprt.getLogLikelihoodRatio(results[0], results[1], results[2]) << ")";
+
+	if (decided > 0 && decided < played) {
+		output << " after " << decided << " games, " << played - decided << " more finished after it are counted in the results";
+	}
+
+	output << std::endl;
+
+	return state;
+}
@@ -5,6 +5,16 @@ Move::Move() {}
 /* Parameterized constructor */
 Move::Move(const Position initial, const Position final) : _initial(initial), _final(final) {}
 
+/* Algebraic notation constructor, "e2e4" style (cell (0, 0) is a8) */
+Move::Move(const std::string algebraic) : _initial(-1, -1), _final(-1, -1) {
+	if (algebraic.size() >= 4 &&
+			algebraic[0] >= 'a' && algebraic[0] <= 'h' && algebraic[1] >= '1' && algebraic[1] <= '8' &&
+			algebraic[2] >= 'a' && algebraic[2] <= 'h' && algebraic[3] >= '1' && algebraic[3] <= '8') {
+		_initial.setBoth(algebraic[0] - 'a', '8' - algebraic[1]);
+		_final.setBoth(algebraic[2] - 'a', '8' - algebraic[3]);
+	}
+}
+
 /* Copy constructor */
 Move::Move(const Move &other) : _initial(other._initial), _final(other._final) {}
 
@@ -95,3 +105,18 @@ std::string Move::toString() const {
 
 	return result;
 }
+
+std::string Move::toAlgebraic() const {
+	/*
+	 * Returns the move in "e2e4" style algebraic notation (cell (0, 0) is a8).
+	 */
+
+	std::string result;
+
+	result += (char) ('a' + _initial.getX());
+	result += (char) ('8' - _initial.getY());
+	result += (char) ('a' + _final.getX());
+	result += (char) ('8' - _final.getY());
+
+	return result;
+}
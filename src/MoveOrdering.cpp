@@ -0,0 +1,145 @@
+#include "MoveOrdering.h"
+
+// Worth of every piece type when ordering kills (BISHOP, KING, KNIGHT, PAWN, QUEEN, ROOK)
+static const int ORDER_VALUES[6] = {3, 10, 3, 1, 9, 5};
+
+MoveOrdering::MoveOrdering() {
+	clear();
+}
+
+void MoveOrdering::clear() {
+	/*
+	 * Forgets every killer move and history score.
+	 */
+
+	for (int ply = 0; ply < MAX_PLY; ply++) {
+		_killers[ply][0] = NO_MOVE;
+		_killers[ply][1] = NO_MOVE;
+	}
+
+	for (int color = 0; color < 2; color++) {
+		for (int initial = 0; initial < 64; initial++) {
+			for (int final = 0; final < 64; final++) {
+				_history[color][initial][final] = 0;
+			}
+		}
+	}
+}
+
+void MoveOrdering::age() {
+	/*
+	 * Prepares the tables for a new search: killers belong to the previous game state and are dropped,
+	 * history scores are halved so recent cutoffs weigh more than old ones.
+	 */
+
+	for (int ply = 0; ply < MAX_PLY; ply++) {
+		_killers[ply][0] = NO_MOVE;
+		_killers[ply][1] = NO_MOVE;
+	}
+
+	for (int color = 0; color < 2; color++) {
+		for (int initial = 0; initial < 64; initial++) {
+			for (int final = 0; final < 64; final++) {
+				_history[color][initial][final] /= 2;
+			}
+		}
+	}
+}
+
+void MoveOrdering::score(const Game &game, const MoveList &moves, int scores[], const CompactMove tableMove, const int ply) const {
+	/*
+	 * Scores every move of the list by how likely it is to be the best one: the transposition table move first,
+	 * then kills by most valuable victim and least valuable attacker, then killer moves and finally the rest
+	 * by their history score.
+	 * Game game: game state the moves belong to.
+	 * MoveList moves: legal moves of the active player.
+	 * int scores[]: array where the score of every move is written, in the same order.
+	 * CompactMove tableMove: best move stored in the transposition table, or NO_MOVE if none.
+	 * int ply: turns simulated from the searched game state.
+	 */
+
+	bool color = game.getActiveColor();
+	CompactMove move;
+	int initial;
+	int final;
+	int victim;
+
+	for (int i = 0; i < moves.size(); i++) {
+		move = moves.get(i);
+		initial = move.getInitial();
+		final = move.getFinal();
+		victim = game.getPieceType(final);
+
+		if (move == tableMove && !tableMove.isNone()) {
+			scores[i] = HASH_SCORE;
+		} else if (victim != EMPTY) {
+			scores[i] = CAPTURE_SCORE + ORDER_VALUES[victim]*16 - ORDER_VALUES[game.getPieceType(initial)];
+		} else if (ply < MAX_PLY && move == _killers[ply][0]) {
+			scores[i] = KILLER_SCORE + 1;
+		} else if (ply < MAX_PLY && move == _killers[ply][1]) {
+			scores[i] = KILLER_SCORE;
+		} else {
+			scores[i] = _history[color][initial][final];
+		}
+	}
+}
+
+void MoveOrdering::pick(MoveList &moves, int scores[], const int index) {
+	/*
+	 * Brings the best scored move not tried yet to the given index. Moves are picked one by one instead of
+	 * sorted, since a cutoff usually comes before the last ones are needed.
+	 * MoveList moves: scored moves.
+	 * int scores[]: score of every move.
+	 * int index: position of the next move to try, every move before it has been tried already.
+	 */
+
+	int best = index;
+	int score;
+
+	for (int i = index + 1; i < moves.size(); i++) {
+		if (scores[i] > scores[best]) {
+			best = i;
+		}
+	}
+
+	if (best != index) {
+		moves.swap(index, best);
+		score = scores[index];
+		scores[index] = scores[best];
+		scores[best] = score;
+	}
+}
+
+void MoveOrdering::update(const Game &game, const CompactMove move, const int depth, const int ply) {
+	/*
+	 * Rewards a move that caused a cutoff, if it doesn't kill (kills are already tried early).
+	 * Game game: game state the move belongs to.
+	 * CompactMove move: move that caused the cutoff.
+	 * int depth: turns left to simulate at the game state.
+	 * int ply: turns simulated from the searched game state.
+	 */
+
+	int initial = move.getInitial();
+	int final = move.getFinal();
+	bool color = game.getActiveColor();
+
+	if (game.getPieceType(final) != EMPTY) {
+		return;
+	}
+
+	if (ply < MAX_PLY && _killers[ply][0] != move) {
+		_killers[ply][1] = _killers[ply][0];
+		_killers[ply][0] = move;
+	}
+
+	_history[color][initial][final] += depth*depth;
+
+	// Keep history scores below killer ones, halving all of them when one grows too much
+	if (_history[color][initial][final] > MAX_HISTORY) {
+		for (int i = 0; i < 64; i++) {
+			for (int j = 0; j < 64; j++) {
+				_history[color][i][j] /= 2;
+			}
+		}
+	}
+}
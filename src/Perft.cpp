@@ -0,0 +1,155 @@
+#include "Perft.h"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+/* Reference game states, given as the moves played from the initial state, with their expected leaf counts by depth */
+struct PerftReference {
+	const char *moves;
+	unsigned long long expected[Perft::DEFAULT_DEPTH];
+};
+
+static const PerftReference PERFT_REFERENCES[] = {
+	{"", {20, 400, 8902, 197742, 4896998}},
+	{"e2e4 f7f6 d1h5", {18, 784, 15855, 641946, 14608392}},
+	{"e2e4 d7d5 e4d5 d8d5 b1c3 d5a5", {32, 1227, 40086, 1537316, 52268545}},
+	{"h2h4 g7g5 h4g5 h7h6 g5h6 f8g7 h6h7 e7e6", {24, 722, 19336, 600631, 17493911}},
+	{"e2e4 e7e5 g1f3 b8c6 d2d4 e5d4 f3d4 d8h4 b1c3 f8b4 d1d3", {45, 1935, 84567, 3665964, 157427574}}
+};
+
+static long long microsecondsSince(const std::chrono::steady_clock::time_point start) {
+	/*
+	 * Returns the microseconds passed since start.
+	 */
+
+	return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+unsigned long long Perft::count(Game &game, const int depth) {
+	/*
+	 * Counts the game states reached after playing exactly depth turns.
+	 * Moves that end the game are leaves, so they only count when no turns are left after them.
+	 * Returns the number of game states found.
+	 * Game game: game state to start from, left as it was when done.
+	 * int depth: number of turns to play.
+	 */
+
+	if (depth == 0) {
+		return 1;
+	}
+
+	unsigned long long nodes = 0;
+	MoveList moves;
+
+	// Every legal move at the last turn is a leaf, there is no need to play them
+	if (depth == 1) {
+		Bitboard pieces = game.getOccupancy(game.getActiveColor());
+
+		while (pieces) {
+			nodes += popCount(game.getLegalTargets(popLowestSquare(pieces)));
+		}
+
+		return nodes;
+	}
+
+	game.generateMoves(moves);
+
+	for (int i = 0; i < moves.size(); i++) {
+		if (game.isGameOver(moves.get(i))) {
+			continue;
+		}
+
+		game.makeMove(moves.get(i));
+		nodes += count(game, depth - 1);
+		game.unmakeMove();
+	}
+
+	return nodes;
+}
+
+unsigned long long Perft::divide(Game &game, const int depth) {
+	/*
+	 * Counts the game states reached after playing exactly depth turns, printing the count below every first move
+	 * followed by the total and the speed.
+	 * Returns the number of game states found.
+	 * Game game: game state to start from, left as it was when done.
+	 * int depth: number of turns to play, at least 1.
+	 */
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	unsigned long long nodes = 0;
+	unsigned long long moveNodes;
+	MoveList moves;
+
+	game.generateMoves(moves);
+
+	for (int i = 0; i < moves.size(); i++) {
+		CompactMove move = moves.get(i);
+
+		if (depth == 1) {
+			moveNodes = 1;
+		} else if (game.isGameOver(move)) {
+			moveNodes = 0;
+		} else {
+			game.makeMove(move);
+			moveNodes = count(game, depth - 1);
+			game.unmakeMove();
+		}
+
+		std::cout << move.toAlgebraic() << ": " << moveNodes << std::endl;
+		nodes += moveNodes;
+	}
+
+	long long elapsed = microsecondsSince(start);
+
+	std::cout << std::endl << "Nodes: " << nodes << std::endl << "Time: " << elapsed/1000 << " ms" << std::endl <<
+			"Nodes/s: " << (elapsed > 0 ? nodes*1000000/elapsed : 0) << std::endl;
+
+	return nodes;
+}
+
+bool Perft::runReference(const int maxDepth) {
+	/*
+	 * Counts every reference game state up to maxDepth turns, printing counts, expected counts and speed.
+	 * Returns true if every count matched, false if not.
+	 * int maxDepth: deepest count, up to DEFAULT_DEPTH.
+	 */
+
+	bool passed = true;
+	unsigned long long totalNodes = 0;
+	long long totalElapsed = 0;
+
+	std::cout << std::setw(4) << "pos" << std::setw(7) << "depth" << std::setw(14) << "nodes" << std::setw(14) << "expected" <<
+			std::setw(10) << "ms" << std::setw(14) << "nodes/s" << std::endl;
+
+	for (unsigned int i = 0; i < sizeof(PERFT_REFERENCES)/sizeof(PERFT_REFERENCES[0]); i++) {
+		Game game(Game::BOTVBOT);
+
+		if (!game.playMoves(PERFT_REFERENCES[i].moves)) {
+			std::cout << "Illegal perft moves " << PERFT_REFERENCES[i].moves << std::endl;
+			return false;
+		}
+
+		for (int depth = 1; depth <= std::min(maxDepth, (int) DEFAULT_DEPTH); depth++) {
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			unsigned long long nodes = count(game, depth);
+			long long elapsed = microsecondsSince(start);
+			bool matched = nodes == PERFT_REFERENCES[i].expected[depth - 1];
+
+			passed = passed && matched;
+			totalNodes += nodes;
+			totalElapsed += elapsed;
+
+			std::cout << std::setw(4) << i << std::setw(7) << depth << std::setw(14) << nodes <<
+					std::setw(14) << PERFT_REFERENCES[i].expected[depth - 1] << std::setw(10) << elapsed/1000 <<
+					std::setw(14) << (elapsed > 0 ? nodes*1000000/elapsed : 0) << (matched ? "" : "  FAILED") << std::endl;
+		}
+	}
+
+	std::cout << std::endl << "Total: " << totalNodes << " nodes in " << totalElapsed/1000 << " ms (" <<
+			(totalElapsed > 0 ? totalNodes*1000000/totalElapsed : 0) << " nodes/s), " <<
+			(passed ? "all counts matched" : "some counts FAILED") << std::endl;
+
+	return passed;
+}
@@ -73,54 +73,6 @@ void Piece::setDead() {
 	_alive = false;
 }
 
-void Piece::getDirections(std::vector<Position> &directions) const {
-	/*
-	 * Gets the legal directions that the piece can take.
-	 * vector<Position> directions: vector in which the directions will be saved.
-	 */
-
-	if (_type == KNIGHT) {
-		// Add knight directions
-		directions.push_back(Position(2, 1));
-		directions.push_back(Position(2, -1));
-		directions.push_back(Position(1, 2));
-		directions.push_back(Position(1, -2));
-		directions.push_back(Position(-2, 1));
-		directions.push_back(Position(-2, -1));
-		directions.push_back(Position(-1, 2));
-		directions.push_back(Position(-1, -2));
-	} else {
-		if (_type != BISHOP) {
-			// Add straight directions (if pawn, only add front directions)
-			if (_type != PAWN || _color == BLACK) {
-				directions.push_back(Position(0, 1));
-			}
-
-			if (_type != PAWN || _color == WHITE) {
-				directions.push_back(Position(0, -1));
-			}
-
-			if (_type != PAWN) {
-				directions.push_back(Position(1, 0));
-				directions.push_back(Position(-1, 0));
-			}
-		}
-
-		if (_type != ROOK) {
-			// Add diagonal directions (if pawn, only add front directions)
-			if (_type != PAWN || _color == BLACK) {
-				directions.push_back(Position(1, 1));
-				directions.push_back(Position(-1, 1));
-			}
-
-			if (_type != PAWN || _color == WHITE) {
-				directions.push_back(Position(1, -1));
-				directions.push_back(Position(-1, -1));
-			}
-		}
-	}
-}
-
 void Piece::assignValue() {
 	/*
 	 * Assigns piece value depending on the type.
@@ -1,30 +1,16 @@
 #include "Player.h"
 
-Player::Player() : _color(BLACK), _score(-1) {}
+Player::Player() : _color(BLACK), _score(-1), _pieces(), _occupancy(0) {}
 
 /* Parameterized constructor */
-Player::Player(const bool color) : _color(color), _score(0) {
-	// Reserve memory for 16 positions in vector
-	_positions.reserve(16);
-
-	// Initialize 16 positions depending on color
-	if (color == WHITE) {
-		for (int i = 6; i < 8; i++) {
-			for (int j = 0; j < 8; j++) {
-				_positions.push_back(Position(j, i));
-			}
-		}
-	} else {
-		for (int i = 0; i < 2; i++) {
-			for (int j = 0; j < 8; j++) {
-				_positions.push_back(Position(j, i));
-			}
-		}
-	}
-}
+Player::Player(const bool color) : _color(color), _score(0), _pieces(), _occupancy(0) {}
 
 /* Copy constructor */
-Player::Player(const Player &other) : _color(other._color), _score(other._score), _positions(other._positions) {}
+Player::Player(const Player &other) : _color(other._color), _score(other._score), _occupancy(other._occupancy) {
+	for (int i = 0; i < 6; i++) {
+		_pieces[i] = other._pieces[i];
+	}
+}
 
 Player& Player::operator=(const Player &other) {
 	/*
@@ -35,65 +21,82 @@ Player& Player::operator=(const Player &other) {
 	// Member-wise assignment
 	_color = other._color;
 	_score = other._score;
-	_positions = other._positions;
+	_occupancy = other._occupancy;
+
+	for (int i = 0; i < 6; i++) {
+		_pieces[i] = other._pieces[i];
+	}
 
 	return *this;
 }
 
 void Player::init(const bool color) {
 	/*
-	 * Initialize a player object.
+	 * Initialize a player object with no pieces on the board.
 	 */
 
 	// Initialize color and score
 	_color = color;
 	_score = 0;
 
-	// Reserve memory for 16 positions in vector
-	_positions.clear();
-	_positions.reserve(16);
-
-	// Initialize 16 positions depending on color
-	if (color == WHITE) {
-		for (int i = 6; i < 8; i++) {
-			for (int j = 0; j < 8; j++) {
-				_positions.push_back(Position(j, i));
-			}
-		}
-	} else {
-		for (int i = 0; i < 2; i++) {
-			for (int j = 0; j < 8; j++) {
-				_positions.push_back(Position(j, i));
-			}
-		}
+	// Clear every piece bitboard
+	for (int i = 0; i < 6; i++) {
+		_pieces[i] = 0;
 	}
+
+	_occupancy = 0;
 }
 
-std::vector<Position> Player::getPositions() const {
+Bitboard Player::getPieces(const int type) const {
 	/*
-	 * Returns vector of positions.
+	 * Returns bitboard of the player pieces of the given type.
 	 */
 
-	return _positions;
+	return _pieces[type];
 }
 
-void Player::killPiece(const Position position) {
-	for (unsigned int i = 0; i < _positions.size(); i++) {
-		if (_positions[i] == position) {
-			_positions.erase(_positions.begin() + i);
-			_positions.shrink_to_fit();
-			break;
-		}
-	}
+Bitboard Player::getOccupancy() const {
+	/*
+	 * Returns bitboard of all the player pieces.
+	 */
+
+	return _occupancy;
 }
 
-void Player::updatePosition(const Move move) {
-	for (unsigned int i = 0; i < _positions.size(); i++) {
-		if (_positions[i] == move.getInitial()) {
-			_positions[i] = move.getFinal();
-			break;
-		}
-	}
+void Player::addPiece(const int type, const int square) {
+	/*
+	 * Places a new piece on the board.
+	 * int type: piece type.
+	 * int square: cell index (y*8 + x).
+	 */
+
+	_pieces[type] |= squareBit(square);
+	_occupancy |= squareBit(square);
+}
+
+void Player::killPiece(const int type, const int square) {
+	/*
+	 * Removes a piece from the board.
+	 * int type: piece type.
+	 * int square: cell index (y*8 + x).
+	 */
+
+	_pieces[type] &= ~squareBit(square);
+	_occupancy &= ~squareBit(square);
+}
+
+void Player::updatePosition(const int type, const int initial, const int final) {
+	/*
+	 * Moves a piece from one cell to another.
+	 * int type: piece type.
+	 * int initial: cell index the piece leaves.
+	 * int final: cell index the piece arrives to.
+	 */
+
+	Bitboard change = squareBit(initial) | squareBit(final);
+
+	_pieces[type] ^= change;
+	_occupancy ^= change;
 }
 
 std::string Player::toString() const {
@@ -101,6 +104,8 @@ std::string Player::toString() const {
 	 * Returns object's string version.
 	 */
 
+	Bitboard pieces = _occupancy;
+
 	// Add color and score to the result string
 	std::string result = "Color: ";
 
@@ -112,13 +117,14 @@ std::string Player::toString() const {
 
 	result += "Score: " + std::to_string(_score) + "\n";
 
-	// Add each position to the result string, except the last one
-	for (unsigned int i = 0; i < _positions.size() - 1; i++) {
-		result += "(" + _positions[i].toString() + ") - ";
-	}
+	// Add each position to the result string, separated by dashes
+	while (pieces) {
+		result += "(" + toPosition(popLowestSquare(pieces)).toString() + ")";
 
-	// Add last position to the result string
-	result += "(" + _positions[_positions.size() - 1].toString() + ")";
+		if (pieces) {
+			result += " - ";
+		}
+	}
 
 	return result;
 }
@@ -0,0 +1,372 @@
+#include "Search.h"
+#include "Trace.h"
+#include <thread>
+
+Search::Search() : _stop(false), _currentDepth(0), _currentScore(0), _currentMove(0), _parallelMode(LAZY_SMP), _probes(0), _hits(0), _statsOutput(NULL) {
+	setThreads(1);
+}
+
+/* Parameterized constructor */
+Search::Search(const int hashSize) : _table(hashSize), _stop(false), _currentDepth(0), _currentScore(0), _currentMove(0), _parallelMode(LAZY_SMP), _probes(0), _hits(0), _statsOutput(NULL) {
+	setThreads(1);
+}
+
+void Search::setHashSize(const int megabytes) {
+	/*
+	 * Resizes the transposition table, losing its contents.
+	 * int megabytes: new table size.
+	 */
+
+	_table.resize(megabytes);
+}
+
+void Search::setThreads(const int threads) {
+	/*
+	 * Sets how many threads search at once: the main one plus threads - 1 helpers.
+	 * int threads: number of threads, clamped to [1, MAX_THREADS].
+	 */
+
+	int count = threads < 1 ? 1 : (threads > MAX_THREADS ? MAX_THREADS : threads);
+
+	_workers.clear();
+
+	for (int i = 0; i < count; i++) {
+		_workers.push_back(std::unique_ptr<Worker>(new Worker(*this, i)));
+	}
+}
+
+int Search::getThreads() const {
+	/*
+	 * Returns the number of searching threads.
+	 */
+
+	return _workers.size();
+}
+
+void Search::setParallelMode(const int mode) {
+	/*
+	 * Sets how helper threads take part in the search.
+	 * int mode: LAZY_SMP (helpers search the same moves and only share results through the
+	 * transposition table) or SPLIT_POINTS (helpers steal the remaining moves of nodes whose
+	 * first move is already searched, Young Brothers Wait).
+	 */
+
+	_parallelMode = mode;
+}
+
+int Search::getParallelMode() const {
+	/*
+	 * Returns how helper threads take part in the search (LAZY_SMP or SPLIT_POINTS).
+	 */
+
+	return _parallelMode;
+}
+
+bool Search::stealTask(Task &task, const int thief) {
+	/*
+	 * Steals a task published by any worker other than the thief.
+	 * Returns true if a task was stolen.
+	 * int thief: index of the stealing worker.
+	 */
+
+	int count = _workers.size();
+
+	for (int i = 1; i < count; i++) {
+		if (_workers[(thief + i) % count]->steal(task)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+TranspositionTable& Search::getTable() {
+	/*
+	 * Returns the transposition table shared by every search and every thread.
+	 */
+
+	return _table;
+}
+
+TimeManager& Search::getTimeManager() {
+	/*
+	 * Returns the time manager holding the limits of every search.
+	 */
+
+	return _timeManager;
+}
+
+Book& Search::getBook() {
+	/*
+	 * Returns the opening book probed before every search, which may have no file open.
+	 */
+
+	return _book;
+}
+
+Tablebase& Search::getTablebase() {
+	/*
+	 * Returns the endgame tables probed during every search, which may have no files open.
+	 */
+
+	return _tablebase;
+}
+
+void Search::stop() {
+	/*
+	 * Asks the running search to stop as soon as possible.
+	 * The best move of the last completed iteration is returned.
+	 */
+
+	_stop = true;
+}
+
+void Search::clearStop() {
+	/*
+	 * Drops a stop request made before the search started.
+	 * Call it before starting a search on another thread, so a stop sent right after is not lost.
+	 */
+
+	_stop = false;
+}
+
+bool Search::isStopped() const {
+	/*
+	 * Returns true if the running search has been asked to stop.
+	 */
+
+	return _stop.load(std::memory_order_relaxed);
+}
+
+unsigned long long Search::getNodes() const {
+	/*
+	 * Returns the number of nodes visited by every thread during the last search.
+	 */
+
+	unsigned long long nodes = 0;
+
+	for (auto &worker : _workers) {
+		nodes += worker->getNodes();
+	}
+
+	return nodes;
+}
+
+int Search::getCompletedDepth() const {
+	/*
+	 * Returns the depth of the last iteration completed by the main thread during the last search.
+	 */
+
+	return _workers[0]->getCompletedDepth();
+}
+
+void Search::report(const int depth, const CompactMove move, const int score) {
+	/*
+	 * Publishes the result of the last iteration completed by the main thread, so that other threads
+	 * can show the progress of a running search.
+	 */
+
+	_currentMove = move.getData();
+	_currentScore = score;
+	_currentDepth = depth;
+}
+
+int Search::getCurrentDepth() const {
+	/*
+	 * Returns the depth of the last iteration completed so far by the running search, 0 if none.
+	 */
+
+	return _currentDepth;
+}
+
+int Search::getCurrentScore() const {
+	/*
+	 * Returns the score of the best move found so far by the running search.
+	 */
+
+	return _currentScore;
+}
+
+CompactMove Search::getCurrentMove() const {
+	/*
+	 * Returns the best move found so far by the running search, NO_MOVE if none.
+	 */
+
+	return CompactMove::fromData(_currentMove);
+}
+
+unsigned long long Search::getCurrentNodes() const {
+	/*
+	 * Returns the number of nodes visited so far by every thread of the running search.
+	 */
+
+	unsigned long long nodes = 0;
+
+	for (auto &worker : _workers) {
+		nodes += worker->getReportedNodes();
+	}
+
+	return nodes;
+}
+
+double Search::getHitRate() const {
+	/*
+	 * Returns the fraction of transposition table probes that found their game state since the last reset.
+	 */
+
+	return _probes ? (double) _hits / _probes : 0.0;
+}
+
+void Search::resetStats() {
+	/*
+	 * Resets transposition table probe and hit counters.
+	 */
+
+	_probes = 0;
+	_hits = 0;
+}
+
+const SearchStats& Search::getStats() const {
+	/*
+	 * Returns the counters of the last search.
+	 */
+
+	return _stats;
+}
+
+void Search::setStatsOutput(std::ostream *output) {
+	/*
+	 * Sets where the counters of every search are written as a JSON line, NULL for nowhere.
+	 */
+
+	_statsOutput = output;
+}
+
+std::tuple<Move, int> Search::botChoice(const Game &game) {
+	/*
+	 * Chooses the move of the active player, see chooseMove, keeping the counters of the search.
+	 * Returns a tuple containing the chosen move and the score associated with it.
+	 * Game game: game whose active player has to move.
+	 */
+
+	TRACE_SPAN("Search::botChoice", "search");
+
+	std::tuple<Move, int> choice;
+
+	_stats = SearchStats();
+	choice = chooseMove(game);
+
+	_stats.move = std::get<0>(choice).getInitial() == Position(-1, -1) ? NO_MOVE : game.encodeMove(std::get<0>(choice));
+	_stats.score = std::get<1>(choice);
+	_stats.elapsed = _stats.move.isNone() ? 0 : _timeManager.getElapsed();
+
+	if (_statsOutput != NULL) {
+		*_statsOutput << _stats.toJson() << std::endl;
+	}
+
+	TRACE_SPAN_ARGS(_stats.toJson());
+
+	// The search is over, so the next one starts unstopped
+	_stop = false;
+
+	return choice;
+}
+
+std::tuple<Move, int> Search::chooseMove(const Game &game) {
+	/*
+	 * Chooses the best move by searching one turn deeper each iteration until a limit is reached,
+	 * unless the opening book or the endgame tables have moves for the game.
+	 * Helper threads search too, and the main thread choice is returned.
+	 * Returns a tuple containing the chosen move and the score associated with it.
+	 * Game game: game whose active player has to move.
+	 */
+
+	MoveList legalMoves;
+	std::vector<CompactMove> moves;
+	std::vector<std::thread> helpers;
+
+	// Get all the legal moves of the active player
+	game.generateMoves(legalMoves);
+
+	for (int i = 0; i < legalMoves.size(); i++) {
+		moves.push_back(legalMoves.get(i));
+	}
+
+	// No legal moves left, nothing to choose from
+	if (moves.empty()) {
+		return {Move(Position(-1, -1), Position(-1, -1)), 0};
+	}
+
+	_table.newSearch();
+	_timeManager.start();
+	_currentDepth = 0;
+	_currentScore = 0;
+	_currentMove = NO_MOVE.getData();
+
+	for (auto &worker : _workers) {
+		worker->init(game, moves);
+	}
+
+	// Moves found in the opening book need no search
+	if (_book.isOpen()) {
+		CompactMove bookMove = _book.probe(game);
+
+		if (!bookMove.isNone()) {
+			return {bookMove.toMove(), 0};
+		}
+	}
+
+	// Won or lost endgames are played straight from the tables
+	if (_tablebase.isOpen()) {
+		int value;
+		CompactMove tableMove = _tablebase.probeRoot(game, value);
+
+		if (!tableMove.isNone()) {
+			return {tableMove.toMove(), fromTablebase(value, 0)};
+		}
+	}
+
+	// Start helpers, then search on this thread until the limits are reached
+	for (unsigned int i = 1; i < _workers.size(); i++) {
+		if (_parallelMode == SPLIT_POINTS) {
+			helpers.push_back(std::thread(&Worker::help, _workers[i].get()));
+		} else {
+			helpers.push_back(std::thread(&Worker::iterate, _workers[i].get()));
+		}
+	}
+
+	_workers[0]->iterate();
+
+	// Stop helpers that are still searching
+	_stop = true;
+
+	for (auto &helper : helpers) {
+		helper.join();
+	}
+
+	for (auto &worker : _workers) {
+		_stats.add(worker->getStats());
+	}
+
+	_stats.depth = _workers[0]->getCompletedDepth();
+	_stats.branchingFactor = _workers[0]->getStats().branchingFactor;
+	_probes += _stats.probes;
+	_hits += _stats.hits;
+
+	return {_workers[0]->getChosenMove().toMove(), _workers[0]->getChosenScore()};
+}
+
+int Search::fromTablebase(const int value, const int ply) {
+	/*
+	 * Returns the search score of an endgame table result, scored like the kill it leads to.
+	 * int value: result for the active player, as stored in the tables.
+	 * int ply: turns simulated from the searched game state.
+	 */
+
+	if (value == Tablebase::DRAW) {
+		return 0;
+	}
+
+	// The king is killed on the ply the result counts to, by the active player if it is odd
+	return value % 2 == 1 ? WIN_SCORE - (ply + value - 1) : -(WIN_SCORE - (ply + value - 1));
+}
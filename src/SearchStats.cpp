@@ -0,0 +1,46 @@
+#include "SearchStats.h"
+#include <iomanip>
+#include <sstream>
+
+SearchStats::SearchStats() : move(NO_MOVE), score(0), depth(0), elapsed(0), nodes(0), quiescenceNodes(0), cutoffs(0),
+		firstMoveCutoffs(0), probes(0), hits(0), branchingFactor(0) {}
+
+void SearchStats::add(const SearchStats &other) {
+	/*
+	 * Adds the counters of another worker of the same search.
+	 */
+
+	nodes += other.nodes;
+	quiescenceNodes += other.quiescenceNodes;
+	cutoffs += other.cutoffs;
+	firstMoveCutoffs += other.firstMoveCutoffs;
+	probes += other.probes;
+	hits += other.hits;
+}
+
+std::string SearchStats::toJson() const {
+	/*
+	 * Returns the counters as a single line JSON object, along with the rates derived from them:
+	 * nodes per second, share of cutoffs caused by the first move searched and share of table probes that hit.
+	 */
+
+	std::ostringstream json;
+
+	json << std::fixed << std::setprecision(3);
+	json << "{\"move\":\"" << (move.isNone() ? "0000" : move.toAlgebraic()) << "\"";
+	json << ",\"score\":" << score;
+	json << ",\"depth\":" << depth;
+	json << ",\"time\":" << elapsed;
+	json << ",\"nodes\":" << nodes;
+	json << ",\"qnodes\":" << quiescenceNodes;
+	json << ",\"nps\":" << (elapsed > 0 ? nodes*1000/elapsed : nodes);
+	json << ",\"ebf\":" << branchingFactor;
+	json << ",\"cutoffs\":" << cutoffs;
+	json << ",\"firstMoveCutoffRate\":" << (cutoffs > 0 ? (double) firstMoveCutoffs/cutoffs : 0.0);
+	json << ",\"ttProbes\":" << probes;
+	json << ",\"ttHits\":" << hits;
+	json << ",\"ttHitRate\":" << (probes > 0 ? (double) hits/probes : 0.0);
+	json << "}";
+
+	return json.str();
+}
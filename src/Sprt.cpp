@@ -0,0 +1,118 @@
+#include "Sprt.h"
+#include <math.h>
+
+static bool getScoreMoments(const int wins, const int draws, const int losses, double &score, double &variance) {
+	/*
+	 * Computes the mean and the variance of the score of a game from the results of a match, adding
+	 * half a game of each result so that one-sided results, such as every game won, still have variance.
+	 * Returns false if no game was played.
+	 */
+
+	double games = wins + draws + losses + 1.5;
+
+	if (wins + draws + losses == 0) {
+		return false;
+	}
+
+	score = (wins + 0.5 + 0.5*(draws + 0.5))/games;
+	variance = ((wins + 0.5)*(1 - score)*(1 - score) + (draws + 0.5)*(0.5 - score)*(0.5 - score) +
+			(losses + 0.5)*score*score)/games;
+
+	return true;
+}
+
+Sprt::Sprt() : _elo0(0), _elo1(5), _alpha(0.05), _beta(0.05) {}
+
+/* Parameterized constructor */
+Sprt::Sprt(const double elo0, const double elo1, const double alpha, const double beta) : _elo0(elo0), _elo1(elo1),
+		_alpha(alpha), _beta(beta) {}
+
+double Sprt::getLowerBound() const {
+	/*
+	 * Returns the log-likelihood ratio below which H0 is accepted.
+	 */
+
+	return log(_beta/(1 - _alpha));
+}
+
+double Sprt::getUpperBound() const {
+	/*
+	 * Returns the log-likelihood ratio above which H1 is accepted.
+	 */
+
+	return log((1 - _beta)/_alpha);
+}
+
+double Sprt::getLogLikelihoodRatio(const int wins, const int draws, const int losses) const {
+	/*
+	 * Returns how much more likely the results are under H1 than under H0, as a natural logarithm.
+	 * int wins, draws, losses: results of the first engine.
+	 */
+
+	double score;
+	double variance;
+	double score0 = toScore(_elo0);
+	double score1 = toScore(_elo1);
+
+	if (!getScoreMoments(wins, draws, losses, score, variance)) {
+		return 0;
+	}
+
+	return (wins + draws + losses)*(score1 - score0)*(2*score - score0 - score1)/(2*variance);
+}
+
+int Sprt::getState(const int wins, const int draws, const int losses) const {
+	/*
+	 * Returns ACCEPT_H0 or ACCEPT_H1 once the results are conclusive, CONTINUE while they aren't.
+	 */
+
+	double ratio = getLogLikelihoodRatio(wins, draws, losses);
+
+	if (ratio >= getUpperBound()) {
+		return ACCEPT_H1;
+	}
+
+	if (ratio <= getLowerBound()) {
+		return ACCEPT_H0;
+	}
+
+	return CONTINUE;
+}
+
+double Sprt::toScore(const double elo) {
+	/*
+	 * Returns the expected score of a player that is elo points stronger, between 0 and 1.
+	 */
+
+	return 1/(1 + pow(10, -elo/400));
+}
+
+double Sprt::toElo(const double score) {
+	/*
+	 * Returns the Elo difference that gives the expected score, between 0 and 1 excluded.
+	 */
+
+	return -400*log10(1/score - 1);
+}
+
+double Sprt::getEloError(const int wins, const int draws, const int losses) {
+	/*
+	 * Returns the half width of the 95% confidence interval of the Elo difference of the results,
+	 * or 0 if there are too few results to tell.
+	 */
+
+	double score;
+	double variance;
+
+	if (!getScoreMoments(wins, draws, losses, score, variance)) {
+		return 0;
+	}
+
+	double deviation = sqrt(variance/(wins + draws + losses));
+
+	if (score - 1.96*deviation <= 0 || score + 1.96*deviation >= 1) {
+		return 0;
+	}
+
+	return (toElo(score + 1.96*deviation) - toElo(score - 1.96*deviation))/2;
+}
@@ -0,0 +1,782 @@
+#include "Tablebase.h"
+#include <algorithm>
+#include <fstream>
+#include <string.h>
+
+/* Letter of every piece type in material names, indexed by type */
+static const char PIECE_LETTERS[] = "BKNPQR";
+
+/* Piece types other than the king, strongest first: the order of pieces in material names and table indexes */
+static const int PIECE_ORDER[5] = {QUEEN, ROOK, BISHOP, KNIGHT, PAWN};
+
+/* Number of base 6 codes of the ranks of up to MAX_PIECES - 2 pieces, see getSignature */
+static const int RANK_CODES = 6*6*6;
+
+/* Pieces of a material in table index order: white king, white pieces, black king and black pieces */
+struct Layout {
+	int count;
+	int colors[Tablebase::MAX_PIECES];
+	int types[Tablebase::MAX_PIECES];
+};
+
+static int getRank(const int type) {
+	/*
+	 * Returns the position of a piece type in PIECE_ORDER, -1 for the king.
+	 */
+
+	for (int i = 0; i < 5; i++) {
+		if (PIECE_ORDER[i] == type) {
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+static bool isStronger(const int first[], const int firstCount, const int second[], const int secondCount) {
+	/*
+	 * Returns true if the first side goes first in material names: it has more pieces, or as many
+	 * and the strongest different one is its own. Both sides are given as piece types sorted by rank.
+	 */
+
+	if (firstCount != secondCount) {
+		return firstCount > secondCount;
+	}
+
+	for (int i = 0; i < firstCount; i++) {
+		if (first[i] != second[i]) {
+			return getRank(first[i]) < getRank(second[i]);
+		}
+	}
+
+	return true;
+}
+
+static bool isStronger(const std::vector<int> &first, const std::vector<int> &second) {
+	/*
+	 * Returns true if the first side goes first in material names, for sides given as vectors.
+	 */
+
+	return isStronger(first.data(), first.size(), second.data(), second.size());
+}
+
+static int getSignature(const int strong[], const int strongCount, const int weak[], const int weakCount) {
+	/*
+	 * Returns the slot of a material in the table index, below Tablebase::MAX_SIGNATURES: the ranks of the
+	 * pieces besides the kings as base 6 digits, plus RANK_CODES times the number of the stronger side's.
+	 * Both sides are given as piece types sorted by rank, with up to MAX_PIECES pieces in all.
+	 */
+
+	int signature = 0;
+
+	for (int i = 0; i < weakCount; i++) {
+		signature = signature*6 + getRank(weak[i]) + 1;
+	}
+
+	for (int i = 0; i < strongCount; i++) {
+		signature = signature*6 + getRank(strong[i]) + 1;
+	}
+
+	return strongCount*RANK_CODES + signature;
+}
+
+static std::string toName(const std::vector<int> &white, const std::vector<int> &black) {
+	/*
+	 * Returns the material name of the pieces of both sides, kings excluded, like "KQvKR".
+	 */
+
+	std::string name = "K";
+
+	for (auto type : white) {
+		name += PIECE_LETTERS[type];
+	}
+
+	name += "vK";
+
+	for (auto type : black) {
+		name += PIECE_LETTERS[type];
+	}
+
+	return name;
+}
+
+static bool toLayout(const std::string material, Layout &layout) {
+	/*
+	 * Reads the pieces of a material name.
+	 * Returns false if the name is not valid.
+	 */
+
+	int color = WHITE;
+	const char *letter;
+
+	layout.count = 0;
+
+	for (unsigned int i = 0; i < material.size(); i++) {
+		if (material[i] == 'v' && color == WHITE) {
+			color = BLACK;
+			continue;
+		}
+
+		letter = strchr(PIECE_LETTERS, material[i]);
+
+		if (letter == NULL || material[i] == '\0' || layout.count == Tablebase::MAX_PIECES) {
+			return false;
+		}
+
+		// Every side starts with its king, and has no other king
+		if ((*letter == 'K') != (i == 0 || material[i - 1] == 'v')) {
+			return false;
+		}
+
+		layout.colors[layout.count] = color;
+		layout.types[layout.count] = letter - PIECE_LETTERS;
+		layout.count++;
+	}
+
+	return color == BLACK && layout.count >= 2;
+}
+
+static long long getTableSize(const int count) {
+	/*
+	 * Returns the number of game states of a table: the white king is kept on files a-d, mirroring the
+	 * board if needed, and every other piece may be anywhere.
+	 */
+
+	long long size = 32*2;
+
+	for (int i = 1; i < count; i++) {
+		size *= 64;
+	}
+
+	return size;
+}
+
+static long long toIndex(const int squares[], const int count, const bool color) {
+	/*
+	 * Returns the table index of a game state, given the squares of its pieces in layout order.
+	 * The game rules are the same with files mirrored, so states with the white king on files e-h are
+	 * stored as their mirror image.
+	 */
+
+	int mirror = (squares[0] & 7) >= 4 ? 7 : 0;
+	long long index = (squares[0] >> 3)*4 + ((squares[0] ^ mirror) & 7);
+
+	for (int i = 1; i < count; i++) {
+		index = index*64 + (squares[i] ^ mirror);
+	}
+
+	return index*2 + color;
+}
+
+static void fromIndex(long long index, int squares[], const int count, bool &color) {
+	/*
+	 * Reads the squares of the pieces and the active player of a table index.
+	 */
+
+	color = index & 1;
+	index >>= 1;
+
+	for (int i = count - 1; i > 0; i--) {
+		squares[i] = index & 63;
+		index >>= 6;
+	}
+
+	squares[0] = (index >> 2)*8 + (index & 3);
+}
+
+static bool isValid(const Layout &layout, const int squares[]) {
+	/*
+	 * Returns true if no two pieces share a square and no pawn is on the first or last row.
+	 */
+
+	Bitboard occupancy = 0;
+
+	for (int i = 0; i < layout.count; i++) {
+		if ((occupancy & squareBit(squares[i])) ||
+				(layout.types[i] == PAWN && (squareBit(squares[i]) & (ROW_0 | ROW_7)))) {
+			return false;
+		}
+
+		occupancy |= squareBit(squares[i]);
+	}
+
+	return true;
+}
+
+static Bitboard getTargets(const int type, const int color, const int square, const Bitboard occupancy[2]) {
+	/*
+	 * Returns the cells a piece can move to, following the same rules as Game::getLegalTargets.
+	 */
+
+	Bitboard all = occupancy[BLACK] | occupancy[WHITE];
+	Bitboard targets;
+
+	if (type == PAWN) {
+		if (color == BLACK) {
+			targets = (squareBit(square) << 8) & ~all;
+			targets |= ((targets & (ROW_1 << 8)) << 8) & ~all;
+		} else {
+			targets = (squareBit(square) >> 8) & ~all;
+			targets |= ((targets & (ROW_6 >> 8)) >> 8) & ~all;
+		}
+
+		return targets | (pawnAttacks(color, square) & occupancy[!color]);
+	} else if (type == KNIGHT) {
+		targets = knightAttacks(square);
+	} else if (type == KING) {
+		targets = kingAttacks(square);
+	} else if (type == BISHOP) {
+		targets = bishopAttacks(square, all);
+	} else if (type == ROOK) {
+		targets = rookAttacks(square, all);
+	} else {
+		targets = queenAttacks(square, all);
+	}
+
+	return targets & ~occupancy[color];
+}
+
+static Bitboard getOrigins(const int type, const int color, const int square, const Bitboard all) {
+	/*
+	 * Returns the empty cells a piece could have come from to its square without killing or promoting.
+	 */
+
+	Bitboard origins;
+
+	if (type == PAWN) {
+		// Pawns come back one row, or two if they can have left their first row
+		if (color == BLACK) {
+			origins = (squareBit(square) >> 8) & ~all & ~ROW_0;
+			origins |= ((origins & (ROW_1 << 8)) >> 8) & ~all;
+		} else {
+			origins = (squareBit(square) << 8) & ~all & ~ROW_7;
+			origins |= ((origins & (ROW_6 >> 8)) << 8) & ~all;
+		}
+
+		return origins;
+	} else if (type == KNIGHT) {
+		origins = knightAttacks(square);
+	} else if (type == KING) {
+		origins = kingAttacks(square);
+	} else if (type == BISHOP) {
+		origins = bishopAttacks(square, all);
+	} else if (type == ROOK) {
+		origins = rookAttacks(square, all);
+	} else {
+		origins = queenAttacks(square, all);
+	}
+
+	return origins & ~all;
+}
+
+Tablebase::Tablebase() : _maxPieces(0) {
+	std::fill(_signatures, _signatures + MAX_SIGNATURES, (const MappedFile*) NULL);
+}
+
+int Tablebase::open(const std::string directory) {
+	/*
+	 * Maps every table found in a directory, closing the tables opened before.
+	 * Returns the number of tables found.
+	 * string directory: directory holding the table files, as written by generate.
+	 */
+
+	close();
+
+	for (int pieces = 2; pieces <= MAX_PIECES; pieces++) {
+		for (auto &material : listMaterials(pieces)) {
+			std::unique_ptr<MappedFile> file(new MappedFile());
+
+			if (file->open(directory + "/" + material + ".tb") && (long long) file->getSize() == getTableSize(pieces)) {
+				Layout layout;
+				int sides[2][MAX_PIECES];
+				int counts[2] = {0, 0};
+
+				toLayout(material, layout);
+
+				for (int i = 0; i < layout.count; i++) {
+					if (layout.types[i] != KING) {
+						sides[layout.colors[i]][counts[layout.colors[i]]++] = layout.types[i];
+					}
+				}
+
+				_signatures[getSignature(sides[WHITE], counts[WHITE], sides[BLACK], counts[BLACK])] = file.get();
+				_tables[material] = std::move(file);
+				_maxPieces = pieces;
+			}
+		}
+	}
+
+	return _tables.size();
+}
+
+void Tablebase::close() {
+	/*
+	 * Unmaps every table.
+	 */
+
+	_tables.clear();
+	std::fill(_signatures, _signatures + MAX_SIGNATURES, (const MappedFile*) NULL);
+	_maxPieces = 0;
+}
+
+bool Tablebase::isOpen() const {
+	/*
+	 * Returns true if any table is mapped.
+	 */
+
+	return !_tables.empty();
+}
+
+int Tablebase::getMaxPieces() const {
+	/*
+	 * Returns the number of pieces of the biggest mapped table, 0 if none.
+	 */
+
+	return _maxPieces;
+}
+
+bool Tablebase::probe(const Game &game, int &value) const {
+	/*
+	 * Reads the result of a game state from its table.
+	 * Returns false if there are too many pieces or there is no table for the material.
+	 * int value: result for the active player, as stored in the tables.
+	 */
+
+	Bitboard occupancy = game.getOccupancy(BLACK) | game.getOccupancy(WHITE);
+	int colors[MAX_PIECES];
+	int types[MAX_PIECES];
+	int squares[MAX_PIECES];
+	int count = 0;
+
+	if (popCount(occupancy) > _maxPieces) {
+		return false;
+	}
+
+	while (occupancy) {
+		squares[count] = popLowestSquare(occupancy);
+		types[count] = game.getPieceType(squares[count]);
+		colors[count] = (game.getOccupancy(WHITE) & squareBit(squares[count])) != 0;
+		count++;
+	}
+
+	return lookup(colors, types, squares, count, game.getActiveColor(), value);
+}
+
+CompactMove Tablebase::probeRoot(const Game &game, int &value) const {
+	/*
+	 * Chooses the move that kills the king soonest in a won game state, or the one that loses it
+	 * latest in a lost one, if the 50 turns rule can't change the result.
+	 * Returns the chosen move, or NO_MOVE if the game state is a draw or isn't in the tables.
+	 * int value: result for the active player after the chosen move, as stored in the tables.
+	 */
+
+	Game child = game;
+	MoveList moves;
+	CompactMove bestMove = NO_MOVE;
+	int bestValue = DRAW;
+	int childValue;
+
+	if (!probe(game, value) || value == DRAW || !isSound(value, game.getNoKillTurns())) {
+		return NO_MOVE;
+	}
+
+	game.generateMoves(moves);
+
+	for (int i = 0; i < moves.size(); i++) {
+		if (game.isGameOver(moves.get(i))) {
+			// Killing the king is as soon as it gets, a draw by the 50 turns rule is never the best move
+			if (game.getPieceType(moves.get(i).getFinal()) == KING) {
+				value = 1;
+				return moves.get(i);
+			}
+
+			continue;
+		}
+
+		child.makeMove(moves.get(i));
+
+		if (probe(child, childValue) && childValue != DRAW) {
+			childValue++;
+
+			// Shorter wins first, then longer losses
+			if (bestMove.isNone() || (childValue % 2 == 1 && (bestValue % 2 == 0 || childValue < bestValue)) ||
+					(childValue % 2 == 0 && bestValue % 2 == 0 && childValue > bestValue)) {
+				bestMove = moves.get(i);
+				bestValue = childValue;
+			}
+		}
+
+		child.unmakeMove();
+	}
+
+	value = bestValue;
+
+	return bestMove;
+}
+
+bool Tablebase::lookup(const int colors[], const int types[], const int squares[], const int count, const bool color,
+		int &value) const {
+	/*
+	 * Reads the result of a game state from its table, given its pieces in any order.
+	 * Returns false if there is no table for the material.
+	 * int colors[], types[], squares[]: color, type and square of every piece.
+	 * bool color: active player.
+	 * int value: result for the active player, as stored in the tables.
+	 */
+
+	int kings[2] = {-1, -1};
+	int ordered[MAX_PIECES];
+	int sides[2][MAX_PIECES];
+	int others[2][MAX_PIECES];
+	int counts[2] = {0, 0};
+	int strong = WHITE;
+	int flip = 0;
+	int index = 0;
+	const MappedFile *table;
+
+	if (count > MAX_PIECES) {
+		return false;
+	}
+
+	// Split the pieces by side, strongest first
+	for (int rank = -1; rank < 5; rank++) {
+		for (int i = 0; i < count; i++) {
+			if (getRank(types[i]) != rank) {
+				continue;
+			}
+
+			if (types[i] == KING) {
+				kings[colors[i]] = squares[i];
+			} else {
+				sides[colors[i]][counts[colors[i]]] = types[i];
+				others[colors[i]][counts[colors[i]]++] = squares[i];
+			}
+		}
+	}
+
+	if (kings[WHITE] < 0 || kings[BLACK] < 0) {
+		return false;
+	}
+
+	// Tables hold the stronger side as white, so swap colors and rows if it is black
+	if (!isStronger(sides[WHITE], counts[WHITE], sides[BLACK], counts[BLACK])) {
+		strong = BLACK;
+		flip = 56;
+	}
+
+	table = _signatures[getSignature(sides[strong], counts[strong], sides[!strong], counts[!strong])];
+
+	if (table == NULL) {
+		return false;
+	}
+
+	ordered[index++] = kings[strong] ^ flip;
+
+	for (int i = 0; i < counts[strong]; i++) {
+		ordered[index++] = others[strong][i] ^ flip;
+	}
+
+	ordered[index++] = kings[!strong] ^ flip;
+
+	for (int i = 0; i < counts[!strong]; i++) {
+		ordered[index++] = others[!strong][i] ^ flip;
+	}
+
+	value = table->getData()[toIndex(ordered, count, flip ? !color : color)];
+
+	return true;
+}
+
+bool Tablebase::isSound(const int value, const int noKillTurns) {
+	/*
+	 * Returns true if the 50 turns rule can't change a result: draws stay draws, and kings killed
+	 * within the turns left are killed before the game is drawn.
+	 */
+
+	return value == DRAW || noKillTurns + value <= 50;
+}
+
+static void addSides(std::vector<std::vector<int>> &sides, std::vector<int> &side, const int pieces, const int first) {
+	/*
+	 * Adds every side with the given number of pieces besides the king, sorted by rank from the given one.
+	 */
+
+	if (pieces == 0) {
+		sides.push_back(side);
+		return;
+	}
+
+	for (int rank = first; rank < 5; rank++) {
+		side.push_back(PIECE_ORDER[rank]);
+		addSides(sides, side, pieces - 1, rank);
+		side.pop_back();
+	}
+}
+
+std::vector<std::string> Tablebase::listMaterials(const int pieces) {
+	/*
+	 * Returns the name of every material with the given number of pieces, kings included.
+	 * Materials with fewer pawns go first, since pawns turning into queens lead to them.
+	 */
+
+	std::vector<std::vector<int>> sides[MAX_PIECES - 1];
+	std::vector<int> side;
+	std::vector<std::pair<int, std::string>> materials;
+	std::vector<std::string> names;
+
+	if (pieces < 2 || pieces > MAX_PIECES) {
+		return names;
+	}
+
+	for (int i = 0; i <= pieces - 2; i++) {
+		addSides(sides[i], side, i, 0);
+	}
+
+	for (int i = 0; i <= pieces - 2; i++) {
+		for (auto &white : sides[i]) {
+			for (auto &black : sides[pieces - 2 - i]) {
+				if (isStronger(white, black)) {
+					materials.push_back(std::make_pair(std::count(white.begin(), white.end(), PAWN) +
+							std::count(black.begin(), black.end(), PAWN), toName(white, black)));
+				}
+			}
+		}
+	}
+
+	std::stable_sort(materials.begin(), materials.end(),
+			[](const std::pair<int, std::string> &a, const std::pair<int, std::string> &b) { return a.first < b.first; });
+
+	for (auto &material : materials) {
+		names.push_back(material.second);
+	}
+
+	return names;
+}
+
+long long Tablebase::generate(const std::string material, const std::string directory, long long counts[3]) {
+	/*
+	 * Solves every game state of a material by retrograde analysis and writes its table to the directory.
+	 * Game states where the active player can kill the king are won in 1 turn. From then on, game states
+	 * are solved one turn further at a time: a state with a move to a lost state is won, and a state whose
+	 * every move leads to a won state is lost. Moves that kill or turn pawns into queens lead to other
+	 * materials, whose tables must be in the directory already. States never solved are draws.
+	 * Returns the number of game states of the table, or -1 if the material is not valid, a table it
+	 * depends on is missing or the file can't be written.
+	 * string material: material name, like "KQvKR", with the stronger side first.
+	 * long long counts[3]: filled with the number of won, lost and drawn game states.
+	 */
+
+	Layout layout;
+	Tablebase others;
+	std::vector<int> sides[2];
+
+	if (!toLayout(material, layout)) {
+		return -1;
+	}
+
+	for (int i = 0; i < layout.count; i++) {
+		if (layout.types[i] != KING) {
+			sides[layout.colors[i]].push_back(layout.types[i]);
+		}
+	}
+
+	// Only the names listMaterials gives are looked up when probing
+	if (toName(sides[WHITE], sides[BLACK]) != material || !isStronger(sides[WHITE], sides[BLACK])) {
+		return -1;
+	}
+
+	others.open(directory);
+
+	long long size = getTableSize(layout.count);
+	std::vector<unsigned char> values(size, DRAW);
+	std::vector<unsigned char> remaining(size, 0);
+	std::vector<unsigned char> longest(size, 0);
+	std::vector<std::vector<unsigned int>> levels(MAX_DISTANCE + 1);
+	int squares[MAX_PIECES];
+	int childSquares[MAX_PIECES];
+	int childTypes[MAX_PIECES];
+	Bitboard occupancy[2];
+	Bitboard targets;
+	bool color;
+	bool kill;
+	int win;
+	int moves;
+	int target;
+	int victim;
+	int childValue;
+
+	// Solve the game states where the king can be killed, and count the moves of the others
+	for (long long index = 0; index < size; index++) {
+		fromIndex(index, squares, layout.count, color);
+
+		if (!isValid(layout, squares)) {
+			continue;
+		}
+
+		occupancy[BLACK] = 0;
+		occupancy[WHITE] = 0;
+
+		for (int i = 0; i < layout.count; i++) {
+			occupancy[layout.colors[i]] |= squareBit(squares[i]);
+		}
+
+		kill = false;
+		win = MAX_DISTANCE + 1;
+		moves = 0;
+
+		for (int i = 0; i < layout.count && !kill; i++) {
+			if (layout.colors[i] != color) {
+				continue;
+			}
+
+			targets = getTargets(layout.types[i], color, squares[i], occupancy);
+
+			while (targets && !kill) {
+				target = popLowestSquare(targets);
+				victim = -1;
+
+				for (int j = 0; j < layout.count; j++) {
+					if (squares[j] == target) {
+						victim = j;
+					}
+				}
+
+				if (victim >= 0 && layout.types[victim] == KING) {
+					kill = true;
+					break;
+				}
+
+				// Moves that keep the material stay in this table, and are solved along with it
+				if (victim < 0 && !(layout.types[i] == PAWN && (squareBit(target) & (ROW_0 | ROW_7)))) {
+					moves++;
+					continue;
+				}
+
+				// Other moves lead to a table solved before
+				int childCount = 0;
+				int childColors[MAX_PIECES];
+
+				for (int j = 0; j < layout.count; j++) {
+					if (j != victim) {
+						childColors[childCount] = layout.colors[j];
+						childTypes[childCount] = layout.types[j];
+						childSquares[childCount] = squares[j];
+
+						if (j == i) {
+							childSquares[childCount] = target;
+
+							if (layout.types[j] == PAWN && (squareBit(target) & (ROW_0 | ROW_7))) {
+								childTypes[childCount] = QUEEN;
+							}
+						}
+
+						childCount++;
+					}
+				}
+
+				if (!others.lookup(childColors, childTypes, childSquares, childCount, !color, childValue)) {
+					return -1;
+				}
+
+				if (childValue == DRAW || childValue + 1 > MAX_DISTANCE) {
+					// A way out of losing, which never runs out
+					moves++;
+				} else if (childValue % 2 == 0) {
+					// The opponent loses after this move
+					win = std::min(win, childValue + 1);
+					moves++;
+				} else {
+					// The opponent wins after this move, only the longest such loss matters
+					longest[index] = std::max((int) longest[index], childValue + 1);
+				}
+			}
+		}
+
+		if (kill) {
+			levels[1].push_back(index);
+			continue;
+		}
+
+		remaining[index] = moves;
+
+		if (win <= MAX_DISTANCE) {
+			levels[win].push_back(index);
+		} else if (moves == 0 && longest[index] > 0) {
+			levels[longest[index]].push_back(index);
+		}
+	}
+
+	// Solve one more turn at a time, from the game states solved in the previous one
+	for (int distance = 1; distance <= MAX_DISTANCE; distance++) {
+		for (unsigned int k = 0; k < levels[distance].size(); k++) {
+			long long index = levels[distance][k];
+
+			if (values[index] != DRAW) {
+				continue;
+			}
+
+			values[index] = distance;
+			fromIndex(index, squares, layout.count, color);
+
+			Bitboard all = 0;
+
+			for (int i = 0; i < layout.count; i++) {
+				all |= squareBit(squares[i]);
+			}
+
+			// Undo every move of the player that moved last
+			for (int i = 0; i < layout.count; i++) {
+				if (layout.colors[i] == color) {
+					continue;
+				}
+
+				int square = squares[i];
+				Bitboard origins = getOrigins(layout.types[i], layout.colors[i], square, all);
+
+				while (origins) {
+					squares[i] = popLowestSquare(origins);
+
+					long long previous = toIndex(squares, layout.count, !color);
+
+					if (values[previous] == DRAW) {
+						if (distance % 2 == 0) {
+							// A move to a lost game state wins
+							if (distance + 1 <= MAX_DISTANCE) {
+								levels[distance + 1].push_back(previous);
+							}
+						} else if (--remaining[previous] == 0) {
+							// Every move leads to a won game state, the longest one decides when it is lost
+							int loss = std::max(distance + 1, (int) longest[previous]);
+
+							if (loss <= MAX_DISTANCE) {
+								levels[loss].push_back(previous);
+							}
+						}
+					}
+				}
+
+				squares[i] = square;
+			}
+		}
+
+		std::vector<unsigned int>().swap(levels[distance]);
+	}
+
+	counts[0] = 0;
+	counts[1] = 0;
+	counts[2] = 0;
+
+	for (long long index = 0; index < size; index++) {
+		fromIndex(index, squares, layout.count, color);
+
+		if (isValid(layout, squares)) {
+			counts[values[index] == DRAW ? 2 : (values[index] % 2 == 1 ? 0 : 1)]++;
+		}
+	}
+
+	std::ofstream file(directory + "/" + material + ".tb", std::ios::binary);
+
+	file.write((const char*) values.data(), size);
+
+	return file ? size : -1;
+}
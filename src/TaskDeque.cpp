@@ -0,0 +1,47 @@
+#include "TaskDeque.h"
+
+void TaskDeque::push(const Task &task) {
+	/*
+	 * Publishes a task at the owner end of the deque.
+	 */
+
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	_tasks.push_back(task);
+}
+
+bool TaskDeque::popBack(Task &task, const SplitPoint *splitPoint) {
+	/*
+	 * Takes the newest task back at the owner end, if it belongs to the given split point.
+	 * Returns true if a task was taken.
+	 */
+
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	if (_tasks.empty() || _tasks.back().splitPoint != splitPoint) {
+		return false;
+	}
+
+	task = _tasks.back();
+	_tasks.pop_back();
+
+	return true;
+}
+
+bool TaskDeque::steal(Task &task) {
+	/*
+	 * Takes the oldest task, which belongs to the shallowest split point and so is the biggest one.
+	 * Returns true if a task was stolen.
+	 */
+
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	if (_tasks.empty()) {
+		return false;
+	}
+
+	task = _tasks.front();
+	_tasks.pop_front();
+
+	return true;
+}
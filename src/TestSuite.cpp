@@ -0,0 +1,387 @@
+#include "TestSuite.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+#include <string.h>
+#include <thread>
+
+TestSuite::TestSuite() : _moveTime(0), _maxNodes(0), _maxDepth(0), _threads(1), _parallelMode(Search::LAZY_SMP),
+		_hashSize(DEFAULT_HASH_SIZE) {}
+
+int TestSuite::load(std::istream &input) {
+	/*
+	 * Adds every position of an EPD file, skipping empty lines and lines starting with '#'.
+	 * Returns the number of lines that couldn't be read.
+	 * istream input: one position per line, see addPosition.
+	 */
+
+	std::string line;
+	int skipped = 0;
+
+	while (std::getline(input, line)) {
+		if (!line.empty() && line.back() == '\r') {
+			line.pop_back();
+		}
+
+		if (line.find_first_not_of(" \t") == std::string::npos || line[line.find_first_not_of(" \t")] == '#') {
+			continue;
+		}
+
+		if (!addPosition(line)) {
+			skipped++;
+		}
+	}
+
+	return skipped;
+}
+
+bool TestSuite::addPosition(const std::string epd) {
+	/*
+	 * Adds a position in Extended Position Description: the first four FEN fields, optionally followed
+	 * by the halfmove and fullmove counters, then operations ending in ';'. The operations read are
+	 * "bm" (best moves), "am" (moves to avoid), "id", "hmvc" and "fmvn"; others are ignored.
+	 * Moves may be written in SAN ("Qxf7+") or in "e2e4" notation.
+	 * Returns true if successful, false if the position or any of its moves can't be read under this game rules.
+	 * string epd: the position, such as 'r1b1k2r/.../R3K2R w KQkq - bm Qxf7+; id "WAC.001";'.
+	 */
+
+	std::istringstream stream(epd);
+	std::string fields[4];
+	std::string token;
+	std::string halfMoves = "0";
+	std::string fullMoves = "1";
+	std::string operations;
+	std::vector<std::string> bestMoves;
+	std::vector<std::string> avoidMoves;
+	TestPosition position;
+	CompactMove move;
+	bool quoted = false;
+
+	for (int i = 0; i < 4; i++) {
+		if (!(stream >> fields[i])) {
+			return false;
+		}
+	}
+
+	std::getline(stream, operations);
+
+	// Counters written as in FEN come before the operations
+	for (int i = 0; i < 2; i++) {
+		std::istringstream counters(operations);
+
+		if (counters >> token && token.find_first_not_of("0123456789") == std::string::npos) {
+			(i == 0 ? halfMoves : fullMoves) = token;
+			std::getline(counters, operations);
+		}
+	}
+
+	// Split the operations on every ';' outside quotes
+	token.clear();
+
+	for (char c : operations) {
+		if (c == '"') {
+			quoted = !quoted;
+		}
+
+		if (c != ';' || quoted) {
+			token += c;
+			continue;
+		}
+
+		std::istringstream operation(token);
+		std::string opcode;
+		std::string operand;
+
+		operation >> opcode;
+
+		while (operation >> operand) {
+			if (opcode == "bm") {
+				bestMoves.push_back(operand);
+			} else if (opcode == "am") {
+				avoidMoves.push_back(operand);
+			} else if (opcode == "hmvc") {
+				halfMoves = operand;
+			} else if (opcode == "fmvn") {
+				fullMoves = operand;
+			} else if (opcode == "id") {
+				position.id += (position.id.empty() ? "" : " ") + operand;
+			}
+		}
+
+		token.clear();
+	}
+
+	if (!position.game.loadFen(fields[0] + " " + fields[1] + " " + fields[2] + " " + fields[3] + " " + halfMoves + " " + fullMoves)) {
+		return false;
+	}
+
+	// Quotes only delimit the id
+	if (position.id.size() >= 2 && position.id.front() == '"' && position.id.back() == '"') {
+		position.id = position.id.substr(1, position.id.size() - 2);
+	}
+
+	if (position.id.empty()) {
+		position.id = std::to_string(_positions.size() + 1);
+	}
+
+	for (auto &text : bestMoves) {
+		if ((move = parseMove(position.game, text)).isNone()) {
+			return false;
+		}
+
+		position.bestMoves.push_back(move);
+	}
+
+	for (auto &text : avoidMoves) {
+		if ((move = parseMove(position.game, text)).isNone()) {
+			return false;
+		}
+
+		position.avoidMoves.push_back(move);
+	}
+
+	_positions.push_back(position);
+
+	return true;
+}
+
+int TestSuite::size() const {
+	/*
+	 * Returns the number of positions in the suite.
+	 */
+
+	return _positions.size();
+}
+
+void TestSuite::setLimits(const long long moveTime, const unsigned long long maxNodes, const int maxDepth) {
+	/*
+	 * Sets the limits of the search of every position, 0 for no limit.
+	 * long long moveTime: milliseconds.
+	 * unsigned long long maxNodes: simulated turns.
+	 * int maxDepth: turns.
+	 */
+
+	_moveTime = moveTime;
+	_maxNodes = maxNodes;
+	_maxDepth = maxDepth;
+}
+
+void TestSuite::setSearch(const int threads, const int parallelMode, const int hashSize) {
+	/*
+	 * Sets up the search of every position.
+	 * int threads: threads searching each position.
+	 * int parallelMode: how helper threads search (Search::LAZY_SMP or Search::SPLIT_POINTS).
+	 * int hashSize: transposition table size in megabytes, for each position searched at the same time.
+	 */
+
+	_threads = threads;
+	_parallelMode = parallelMode;
+	_hashSize = hashSize;
+}
+
+bool TestSuite::isScored(const int index) const {
+	/*
+	 * Returns true if the position has moves to choose or avoid, so its result can be checked.
+	 */
+
+	return !_positions[index].bestMoves.empty() || !_positions[index].avoidMoves.empty();
+}
+
+TestResult TestSuite::runPosition(Search &search, const int index) const {
+	/*
+	 * Searches a position from an empty transposition table.
+	 * Returns the chosen move with the search figures, solved if the move is one of the best moves
+	 * (when there are any) and none of the moves to avoid.
+	 * Search search: search to use, with the suite limits already set.
+	 * int index: position in the suite.
+	 */
+
+	const TestPosition &position = _positions[index];
+	TestResult result;
+
+	search.getTable().clear();
+
+	std::tuple<Move, int> choice = search.botChoice(position.game);
+
+	result.move = std::get<0>(choice).getInitial() == Position(-1, -1) ? NO_MOVE : position.game.encodeMove(std::get<0>(choice));
+	result.score = std::get<1>(choice);
+	result.depth = search.getCompletedDepth();
+	result.nodes = search.getNodes();
+	result.elapsed = search.getTimeManager().getElapsed();
+	result.solved = !result.move.isNone();
+
+	if (!position.bestMoves.empty()) {
+		result.solved = result.solved && std::find(position.bestMoves.begin(), position.bestMoves.end(), result.move) != position.bestMoves.end();
+	}
+
+	if (!position.avoidMoves.empty()) {
+		result.solved = result.solved && std::find(position.avoidMoves.begin(), position.avoidMoves.end(), result.move) == position.avoidMoves.end();
+	}
+
+	return result;
+}
+
+std::vector<TestResult> TestSuite::run(const int jobs, std::ostream &output) const {
+	/*
+	 * Searches every position, several of them at the same time, printing a line per position as it ends
+	 * and a summary with the solved positions, nodes, nodes per second and time per position.
+	 * Returns the result of every position, in suite order.
+	 * int jobs: positions searched at the same time, each one by its own search.
+	 * ostream output: where the report is printed.
+	 */
+
+	std::vector<TestResult> results(_positions.size());
+	std::vector<std::thread> threads;
+	std::atomic<int> next(0);
+	std::mutex outputMutex;
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	unsigned long long nodes = 0;
+	long long searchTime = 0;
+	long long wallTime;
+	int scored = 0;
+	int solved = 0;
+
+	auto work = [&]() {
+		Search search(_hashSize);
+		int index;
+
+		search.getTimeManager().clearLimits();
+		search.getTimeManager().setMoveTime(_moveTime);
+		search.getTimeManager().setMaxNodes(_maxNodes);
+		search.getTimeManager().setMaxDepth(_maxDepth);
+		search.setThreads(_threads);
+		search.setParallelMode(_parallelMode);
+
+		while ((index = next++) < (int) _positions.size()) {
+			results[index] = runPosition(search, index);
+
+			std::lock_guard<std::mutex> lock(outputMutex);
+
+			output << std::setw(6) << index + 1 << "  " << std::left << std::setw(16) << _positions[index].id << std::right <<
+					std::setw(6) << (results[index].move.isNone() ? "none" : results[index].move.toAlgebraic()) <<
+					std::setw(9) << results[index].score << std::setw(4) << results[index].depth <<
+					std::setw(12) << results[index].nodes << std::setw(8) << results[index].elapsed << " ms" <<
+					(isScored(index) ? (results[index].solved ? "  ok" : "  FAIL") : "") << std::endl;
+		}
+	};
+
+	for (int i = 1; i < jobs; i++) {
+		threads.push_back(std::thread(work));
+	}
+
+	work();
+
+	for (auto &thread : threads) {
+		thread.join();
+	}
+
+	wallTime = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+
+	for (unsigned int i = 0; i < results.size(); i++) {
+		nodes += results[i].nodes;
+		searchTime += results[i].elapsed;
+
+		if (isScored(i)) {
+			scored++;
+			solved += results[i].solved;
+		}
+	}
+
+	output << "Solved: " << solved << "/" << scored << std::endl;
+	output << "Positions: " << results.size() << " in " << wallTime << " ms (" <<
+			std::fixed << std::setprecision(1) << (results.empty() ? 0.0 : (double) searchTime/results.size()) <<
+			" ms per position)" << std::endl;
+	output << "Nodes: " << nodes << " (" << (unsigned long long) (wallTime > 0 ? nodes*1000.0/wallTime : 0.0) <<
+			" nodes/s)" << std::endl;
+
+	return results;
+}
+
+CompactMove TestSuite::parseMove(const Game &game, std::string text) {
+	/*
+	 * Reads a move in "e2e4" notation or in Standard Algebraic Notation ("Nf3", "exd5", "e8=Q+", "Rad1").
+	 * Castling and promotions to anything but a queen don't exist in this game, so they are never read.
+	 * Returns the legal move of the active player, or NO_MOVE if there is no such move or it is ambiguous.
+	 * Game game: game whose active player has to move.
+	 * string text: move to be read.
+	 */
+
+	const char *letters = "BKNPQR";
+	const char *letter;
+	MoveList moves;
+	CompactMove result = NO_MOVE;
+	int type = PAWN;
+	int file = -1;
+	int row = -1;
+	int final;
+
+	// Check and annotation marks don't change the move
+	while (!text.empty() && strchr("+#!?", text.back()) != NULL) {
+		text.pop_back();
+	}
+
+	// Moves of the wrong side are not legal, so they are left to the notation below, which rejects them too
+	if (Move(text).getInitial() != Position(-1, -1) && game.isLegalMove(Move(text))) {
+		return game.encodeMove(Move(text));
+	}
+
+	// Pawns only turn into queens
+	if (text.size() > 2 && text[text.size() - 2] == '=') {
+		if (text.back() != 'Q') {
+			return NO_MOVE;
+		}
+
+		text.resize(text.size() - 2);
+	} else if (text.size() > 2 && text[text.size() - 2] >= '1' && text[text.size() - 2] <= '8' && strchr("QRBN", text.back()) != NULL) {
+		if (text.back() != 'Q') {
+			return NO_MOVE;
+		}
+
+		text.pop_back();
+	}
+
+	if (text.size() < 2 || text[text.size() - 2] < 'a' || text[text.size() - 2] > 'h' || text.back() < '1' || text.back() > '8') {
+		return NO_MOVE;
+	}
+
+	final = ('8' - text.back())*8 + text[text.size() - 2] - 'a';
+	text.resize(text.size() - 2);
+
+	if (!text.empty() && (letter = strchr(letters, text[0])) != NULL && *letter != '\0') {
+		type = letter - letters;
+		text.erase(0, 1);
+	}
+
+	// What is left tells apart pieces of the same type reaching the same cell
+	for (char c : text) {
+		if (c >= 'a' && c <= 'h') {
+			file = c - 'a';
+		} else if (c >= '1' && c <= '8') {
+			row = '8' - c;
+		} else if (c != 'x' && c != ':' && c != '-') {
+			return NO_MOVE;
+		}
+	}
+
+	game.generateMoves(moves);
+
+	for (int i = 0; i < moves.size(); i++) {
+		CompactMove move = moves.get(i);
+
+		if (move.getFinal() != final || game.getPieceType(move.getInitial()) != type ||
+				(file >= 0 && move.getInitial() % 8 != file) || (row >= 0 && move.getInitial() / 8 != row)) {
+			continue;
+		}
+
+		if (!result.isNone()) {
+			return NO_MOVE;
+		}
+
+		result = move;
+	}
+
+	return result;
+}
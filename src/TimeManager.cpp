@@ -0,0 +1,133 @@
+#include "TimeManager.h"
+
+TimeManager::TimeManager() : _start(std::chrono::steady_clock::now()), _pondering(false), _softLimit(-1), _hardLimit(-1), _maxNodes(0), _maxDepth(0) {
+	setMoveTime(DEFAULT_MOVE_TIME);
+}
+
+void TimeManager::clearLimits() {
+	/*
+	 * Removes every limit, so searches only end when stopped from outside.
+	 */
+
+	_softLimit = -1;
+	_hardLimit = -1;
+	_maxNodes = 0;
+	_maxDepth = 0;
+}
+
+void TimeManager::setMoveTime(const long long moveTime) {
+	/*
+	 * Gives every move a fixed time budget.
+	 * No new iteration is started past half the budget, as it would hardly finish in time.
+	 * long long moveTime: budget in milliseconds, 0 or less for no time limit.
+	 */
+
+	if (moveTime > 0) {
+		_softLimit = moveTime/2;
+		_hardLimit = moveTime;
+	} else {
+		_softLimit = -1;
+		_hardLimit = -1;
+	}
+}
+
+void TimeManager::setClock(const long long remaining, const long long increment, const int movesToGo) {
+	/*
+	 * Splits the remaining clock time between the moves left until the next time control.
+	 * long long remaining: milliseconds left in the clock.
+	 * long long increment: milliseconds added to the clock after every move.
+	 * int movesToGo: moves until the next time control, 0 or less if unknown.
+	 */
+
+	long long budget = remaining/(movesToGo > 0 ? movesToGo : DEFAULT_MOVES_TO_GO) + increment;
+
+	// Never risk more than half of the clock on a single move
+	_softLimit = budget < remaining/2 ? budget : remaining/2;
+	_hardLimit = 4*budget < remaining/2 ? 4*budget : remaining/2;
+}
+
+void TimeManager::setMaxNodes(const unsigned long long maxNodes) {
+	/*
+	 * Limits the number of simulated turns of every search.
+	 * unsigned long long maxNodes: maximum number of nodes, 0 for no limit.
+	 */
+
+	_maxNodes = maxNodes;
+}
+
+void TimeManager::setMaxDepth(const int maxDepth) {
+	/*
+	 * Limits the depth of every search.
+	 * int maxDepth: maximum number of turns, 0 for no limit.
+	 */
+
+	_maxDepth = maxDepth;
+}
+
+int TimeManager::getMaxDepth() const {
+	/*
+	 * Returns the maximum search depth, 0 if there is no limit.
+	 */
+
+	return _maxDepth;
+}
+
+void TimeManager::start() {
+	/*
+	 * Starts timing a new search.
+	 */
+
+	_start = std::chrono::steady_clock::now();
+}
+
+void TimeManager::setPondering(const bool pondering) {
+	/*
+	 * Sets whether the next searches think on the opponent's time, ignoring every limit but the depth
+	 * until ponderHit is called.
+	 */
+
+	_pondering = pondering;
+}
+
+void TimeManager::ponderHit() {
+	/*
+	 * The opponent played the move the running search was pondering on: the limits apply from now on,
+	 * and the search keeps everything it found so far. Can be called from any thread.
+	 */
+
+	_start = std::chrono::steady_clock::now();
+	_pondering = false;
+}
+
+bool TimeManager::isPondering() const {
+	/*
+	 * Returns true if searches are thinking on the opponent's time.
+	 */
+
+	return _pondering;
+}
+
+long long TimeManager::getElapsed() const {
+	/*
+	 * Returns milliseconds elapsed since the search started.
+	 */
+
+	return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - _start.load()).count();
+}
+
+bool TimeManager::canStartIteration() const {
+	/*
+	 * Returns true if there is time left to start searching one turn deeper.
+	 */
+
+	return _pondering || _softLimit < 0 || getElapsed() < _softLimit;
+}
+
+bool TimeManager::mustStop(const unsigned long long nodes) const {
+	/*
+	 * Returns true if the search must be aborted right away.
+	 * unsigned long long nodes: nodes searched so far.
+	 */
+
+	return !_pondering && ((_maxNodes > 0 && nodes >= _maxNodes) || (_hardLimit >= 0 && getElapsed() >= _hardLimit));
+}
@@ -0,0 +1,174 @@
+#include "Trace.h"
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <mutex>
+
+static std::mutex traceMutex;
+static std::ofstream traceOutput;
+static std::atomic<bool> traceEnabled(false);
+static std::atomic<int> traceThreads(0);
+static std::chrono::steady_clock::time_point traceStart;
+static bool traceEmpty = true;
+
+/* Totals of the calling thread: time in nanoseconds and number of timed scopes */
+static thread_local long long traceDurations[Trace::TOTALS];
+static thread_local long long traceCalls[Trace::TOTALS];
+
+static const char *TOTAL_NAMES[Trace::TOTALS] = {"moveGeneration"};
+
+static int getThreadId() {
+	/*
+	 * Returns a small number telling apart the threads of the timeline, given in order of first use.
+	 */
+
+	static thread_local int id = ++traceThreads;
+
+	return id;
+}
+
+bool Trace::open(const std::string &path) {
+	/*
+	 * Starts recording the timeline to a file, closing the file opened before if any.
+	 * Returns true if successful, false if the file can't be created or tracing isn't built in.
+	 * string path: JSON file to be written.
+	 */
+
+#ifdef CHESS_TRACE
+	close();
+
+	std::lock_guard<std::mutex> lock(traceMutex);
+
+	traceOutput.open(path);
+
+	if (!traceOutput) {
+		return false;
+	}
+
+	traceOutput << "[";
+	traceStart = std::chrono::steady_clock::now();
+	traceEmpty = true;
+	traceEnabled = true;
+
+	return true;
+#else
+	(void) path;
+
+	return false;
+#endif
+}
+
+void Trace::close() {
+	/*
+	 * Stops recording and completes the file, if any.
+	 */
+
+	std::lock_guard<std::mutex> lock(traceMutex);
+
+	if (!traceEnabled) {
+		return;
+	}
+
+	traceEnabled = false;
+	traceOutput << "\n]\n";
+	traceOutput.close();
+}
+
+bool Trace::isEnabled() {
+	/*
+	 * Returns true while the timeline is being recorded.
+	 */
+
+	return traceEnabled.load(std::memory_order_relaxed);
+}
+
+long long Trace::now() {
+	/*
+	 * Returns the microseconds since the recording started.
+	 */
+
+	return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - traceStart).count();
+}
+
+void Trace::write(const char *name, const char *category, const long long start, const long long duration,
+		const std::string args) {
+	/*
+	 * Adds a complete event ("X") to the timeline, on the row of the calling thread.
+	 * string args: JSON object shown along with the event, empty for none.
+	 */
+
+	int thread = getThreadId();
+	std::lock_guard<std::mutex> lock(traceMutex);
+
+	if (!traceEnabled) {
+		return;
+	}
+
+	traceOutput << (traceEmpty ? "\n" : ",\n") << "{\"name\":\"" << name << "\",\"cat\":\"" << category <<
+			"\",\"ph\":\"X\",\"pid\":1,\"tid\":" << thread << ",\"ts\":" << start << ",\"dur\":" << duration;
+
+	if (!args.empty()) {
+		traceOutput << ",\"args\":" << args;
+	}
+
+	traceOutput << "}";
+	traceEmpty = false;
+}
+
+void Trace::addTotal(const int total, const long long duration) {
+	/*
+	 * Adds a timed scope to a total of the calling thread.
+	 * long long duration: nanoseconds spent in the scope.
+	 */
+
+	traceDurations[total] += duration;
+	traceCalls[total]++;
+}
+
+std::string Trace::takeTotals() {
+	/*
+	 * Returns the totals of the calling thread as JSON object members ("moveGenerationUs":...,
+	 * "moveGenerationCalls":...), starting them again from 0.
+	 */
+
+	std::string result;
+
+	for (int i = 0; i < TOTALS; i++) {
+		result += std::string(i > 0 ? "," : "") + "\"" + TOTAL_NAMES[i] + "Us\":" + std::to_string(traceDurations[i]/1000) +
+				",\"" + TOTAL_NAMES[i] + "Calls\":" + std::to_string(traceCalls[i]);
+		traceDurations[i] = 0;
+		traceCalls[i] = 0;
+	}
+
+	return result;
+}
+
+TraceSpan::TraceSpan(const char *name, const char *category) : _name(name), _category(category),
+		_start(Trace::isEnabled() ? Trace::now() : -1) {}
+
+TraceSpan::~TraceSpan() {
+	if (_start >= 0) {
+		Trace::write(_name, _category, _start, Trace::now() - _start, _args);
+	}
+}
+
+void TraceSpan::setArgs(const std::string args) {
+	/*
+	 * Sets the JSON object shown along with the span.
+	 */
+
+	_args = args;
+}
+
+TraceTimer::TraceTimer(const int total) : _total(total), _enabled(Trace::isEnabled()) {
+	// Scopes this short need a finer clock than spans
+	if (_enabled) {
+		_start = std::chrono::steady_clock::now();
+	}
+}
+
+TraceTimer::~TraceTimer() {
+	if (_enabled) {
+		Trace::addTotal(_total, std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - _start).count());
+	}
+}
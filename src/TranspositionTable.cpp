@@ -0,0 +1,143 @@
+#include "TranspositionTable.h"
+
+TranspositionTable::TranspositionTable() : _mask(0), _size(0), _generation(0) {
+	resize(DEFAULT_SIZE);
+}
+
+/* Parameterized constructor */
+TranspositionTable::TranspositionTable(const int megabytes) : _mask(0), _size(0), _generation(0) {
+	resize(megabytes);
+}
+
+void TranspositionTable::resize(const int megabytes) {
+	/*
+	 * Reallocates the table with the biggest power-of-two number of buckets that fits in the given size.
+	 * int megabytes: memory budget for the table (at least one bucket is always allocated).
+	 */
+
+	unsigned long long bytes = (unsigned long long) (megabytes > 0 ? megabytes : 0) << 20;
+	unsigned long long buckets = 1;
+
+	while (buckets*2*sizeof(Bucket) <= bytes) {
+		buckets *= 2;
+	}
+
+	_buckets.reset(new Bucket[buckets]);
+	_mask = buckets - 1;
+	_size = megabytes;
+
+	clear();
+}
+
+void TranspositionTable::clear() {
+	/*
+	 * Empties every entry.
+	 */
+
+	for (unsigned long long i = 0; i <= _mask; i++) {
+		for (int j = 0; j < BUCKET_SIZE; j++) {
+			_buckets[i].entries[j].check.store(0, std::memory_order_relaxed);
+			_buckets[i].entries[j].data.store(0, std::memory_order_relaxed);
+		}
+	}
+
+	_generation = 0;
+}
+
+void TranspositionTable::newSearch() {
+	/*
+	 * Starts a new search generation so entries from older searches get replaced first.
+	 */
+
+	_generation = (_generation + 1) & 63;
+}
+
+bool TranspositionTable::probe(const unsigned long long key, int &depth, int &score, int &bound, CompactMove &move) const {
+	/*
+	 * Looks for a game state in the table. Safe to call while other threads store entries.
+	 * Returns true if found, filling depth, score, bound and best move with the stored ones.
+	 * unsigned long long key: Zobrist key of the game state.
+	 */
+
+	const Bucket &bucket = _buckets[key & _mask];
+	unsigned long long data;
+
+	for (int i = 0; i < BUCKET_SIZE; i++) {
+		data = bucket.entries[i].data.load(std::memory_order_relaxed);
+
+		if ((bucket.entries[i].check.load(std::memory_order_relaxed) ^ data) == key && data != 0) {
+			move = CompactMove::fromData(data & 0xFFFF);
+			depth = (data >> 16) & 255;
+			bound = (data >> 24) & 3;
+			score = (int) (data >> 32);
+
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void TranspositionTable::store(const unsigned long long key, const int depth, const int score, const int bound, const CompactMove move) {
+	/*
+	 * Saves a search result, replacing the same state or else the shallowest and oldest entry of its bucket.
+	 * Safe to call from several threads at once: a torn entry just stops matching any key.
+	 * unsigned long long key: Zobrist key of the game state.
+	 * int depth: turns simulated below the state.
+	 * int score: score found.
+	 * int bound: EXACT, LOWER (score is at least this) or UPPER (score is at most this).
+	 * CompactMove move: best move found, or NO_MOVE if none.
+	 */
+
+	Bucket &bucket = _buckets[key & _mask];
+	Entry *replace = &bucket.entries[0];
+	unsigned long long replaceData = bucket.entries[0].data.load(std::memory_order_relaxed);
+	unsigned long long entryData;
+	unsigned long long moveData = 0;
+	unsigned long long data;
+	bool sameKey = false;
+	int worth;
+	int replaceWorth = INT_MAX;
+
+	for (int i = 0; i < BUCKET_SIZE; i++) {
+		Entry &entry = bucket.entries[i];
+		entryData = entry.data.load(std::memory_order_relaxed);
+
+		if (entryData == 0 || (entry.check.load(std::memory_order_relaxed) ^ entryData) == key) {
+			replace = &entry;
+			replaceData = entryData;
+			sameKey = entryData != 0;
+			break;
+		}
+
+		// Old entries are worth less than new ones, whatever their depth
+		worth = ((entryData >> 16) & 255) - 8*((_generation - ((entryData >> 26) & 63)) & 63);
+
+		if (worth < replaceWorth) {
+			replace = &entry;
+			replaceData = entryData;
+			replaceWorth = worth;
+		}
+	}
+
+	if (!move.isNone()) {
+		moveData = move.getData();
+	} else if (sameKey) {
+		// Keep the best move previously found for the same state
+		moveData = replaceData & 0xFFFF;
+	}
+
+	data = moveData | ((unsigned long long) (depth & 255) << 16) | ((unsigned long long) bound << 24) |
+			((unsigned long long) _generation << 26) | ((unsigned long long) (unsigned int) score << 32);
+
+	replace->check.store(key ^ data, std::memory_order_relaxed);
+	replace->data.store(data, std::memory_order_relaxed);
+}
+
+int TranspositionTable::getSize() const {
+	/*
+	 * Returns the table size in megabytes, as requested on resize.
+	 */
+
+	return _size;
+}
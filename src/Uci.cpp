@@ -0,0 +1,333 @@
+#include "Uci.h"
+#include <algorithm>
+#include "Bench.h"
+
+// Passed by reference to std::min, so it needs storage
+const int Uci::MAX_HASH_SIZE;
+
+Uci::Uci() : _game(Game::BOTVBOT), _stopRequested(false), _infinite(false), _sendStats(false) {}
+
+void Uci::loop() {
+	/*
+	 * Reads UCI commands from the standard input until "quit" or the end of the input.
+	 * Searches run on their own thread, so "stop" and "isready" are answered while searching.
+	 */
+
+	std::string line;
+	std::string token;
+
+	while (std::getline(std::cin, line)) {
+		std::istringstream command(line);
+
+		token.clear();
+		command >> token;
+
+		if (token == "uci") {
+			send("id name Chess2.0");
+			send("id author pperalesm");
+			send("option name Hash type spin default " + std::to_string(TranspositionTable::DEFAULT_SIZE) +
+					" min 1 max " + std::to_string(MAX_HASH_SIZE));
+			send("option name Threads type spin default 1 min 1 max " + std::to_string(Search::MAX_THREADS));
+			send("option name ParallelMode type combo default lazy var lazy var split");
+			send("option name BookFile type string default <empty>");
+			send("option name TablebasePath type string default <empty>");
+			send("option name SearchStats type check default false");
+			send("uciok");
+		} else if (token == "isready") {
+			send("readyok");
+		} else if (token == "setoption") {
+			stopSearch();
+			setOption(command);
+		} else if (token == "ucinewgame") {
+			stopSearch();
+			_search.getTable().clear();
+		} else if (token == "position") {
+			stopSearch();
+			position(command);
+		} else if (token == "go") {
+			stopSearch();
+			go(command);
+		} else if (token == "ponderhit") {
+			ponderHit();
+		} else if (token == "stop") {
+			stopSearch();
+		} else if (token == "bench") {
+			// Non standard: thread scaling report, "bench [threads] [depth]"
+			int threads = 1;
+			int depth = Bench::DEFAULT_DEPTH;
+
+			stopSearch();
+			command >> threads >> depth;
+			Bench().runScaling(threads, depth, _search.getTable().getSize(), _search.getParallelMode());
+		} else if (token == "quit") {
+			break;
+		}
+	}
+
+	stopSearch();
+}
+
+void Uci::position(std::istringstream &command) {
+	/*
+	 * Sets up the game from "position startpos [moves ...]" or "position fen <fen> [moves ...]".
+	 * Moves are applied until the first one that is illegal under this game rules.
+	 */
+
+	std::string token;
+	std::string fen;
+
+	command >> token;
+
+	if (token == "startpos") {
+		_game.init(Game::BOTVBOT);
+		command >> token;
+	} else if (token == "fen") {
+		// The notation runs until the moves, if any
+		while (command >> token && token != "moves") {
+			fen += token + " ";
+		}
+
+		if (!_game.loadFen(fen)) {
+			send("info string invalid fen " + fen);
+			return;
+		}
+	} else {
+		send("info string unknown position " + token);
+		return;
+	}
+
+	if (token != "moves") {
+		return;
+	}
+
+	while (command >> token) {
+		Move move(token);
+
+		if (move.getInitial() == Position(-1, -1) || !_game.isLegalMove(move)) {
+			send("info string illegal move " + token);
+			return;
+		}
+
+		_game.playTurn(_game.encodeMove(move));
+	}
+}
+
+void Uci::go(std::istringstream &command) {
+	/*
+	 * Starts a search with the limits of a "go" command: depth, movetime, nodes,
+	 * wtime, btime, winc, binc, movestogo, ponder and infinite (the default when no limit is given).
+	 * Infinite and pondering searches hold their move until "stop" or "ponderhit".
+	 */
+
+	std::string token;
+	long long moveTime = 0;
+	long long remaining[2] = {0, 0};
+	long long increment[2] = {0, 0};
+	int movesToGo = 0;
+	int depth = 0;
+	unsigned long long nodes = 0;
+	bool infinite = false;
+	bool ponder = false;
+	bool limited = false;
+	bool clock = false;
+	TimeManager &timeManager = _search.getTimeManager();
+
+	while (command >> token) {
+		// Any limit, even an empty clock, means the search ends on its own
+		if (token == "depth" || token == "movetime" || token == "nodes" || token == "wtime" || token == "btime") {
+			limited = true;
+			clock = clock || token == "wtime" || token == "btime";
+		}
+
+		if (token == "depth") {
+			command >> depth;
+		} else if (token == "movetime") {
+			command >> moveTime;
+		} else if (token == "nodes") {
+			command >> nodes;
+		} else if (token == "wtime") {
+			command >> remaining[WHITE];
+		} else if (token == "btime") {
+			command >> remaining[BLACK];
+		} else if (token == "winc") {
+			command >> increment[WHITE];
+		} else if (token == "binc") {
+			command >> increment[BLACK];
+		} else if (token == "movestogo") {
+			command >> movesToGo;
+		} else if (token == "infinite") {
+			infinite = true;
+		} else if (token == "ponder") {
+			ponder = true;
+		}
+	}
+
+	timeManager.clearLimits();
+	timeManager.setMaxDepth(depth);
+	timeManager.setMaxNodes(nodes);
+
+	if (moveTime > 0) {
+		timeManager.setMoveTime(moveTime);
+	} else if (clock) {
+		// A missing or flagged clock leaves no time to think, so the move is sent right away
+		timeManager.setClock(remaining[_game.getActiveColor()], increment[_game.getActiveColor()], movesToGo);
+	}
+
+	timeManager.setPondering(ponder);
+
+	_stopRequested = false;
+	_infinite = infinite || ponder || !limited;
+
+	// Clear the stop flag before the thread starts, so a "stop" that comes right after is not lost
+	_search.clearStop();
+	_searchThread = std::thread(&Uci::think, this);
+}
+
+void Uci::setOption(std::istringstream &command) {
+	/*
+	 * Applies a "setoption name <name> value <value>" command.
+	 * The value is the rest of the line, so paths may contain spaces.
+	 */
+
+	std::string token;
+	std::string name;
+	std::string value;
+
+	command >> token;
+
+	// The name runs until the value, if any
+	while (command >> token && token != "value") {
+		name += (name.empty() ? "" : " ") + token;
+	}
+
+	std::getline(command >> std::ws, value);
+	value.erase(value.find_last_not_of(" \t\r") + 1);
+
+	if (name == "Hash") {
+		_search.setHashSize(std::max(1, std::min(MAX_HASH_SIZE, atoi(value.c_str()))));
+	} else if (name == "Threads") {
+		_search.setThreads(atoi(value.c_str()));
+	} else if (name == "ParallelMode") {
+		_search.setParallelMode(value == "split" ? Search::SPLIT_POINTS : Search::LAZY_SMP);
+	} else if (name == "BookFile") {
+		if (value.empty() || value == "<empty>") {
+			_search.getBook().close();
+		} else if (!_search.getBook().open(value)) {
+			send("info string can't open book " + value);
+		}
+	} else if (name == "TablebasePath") {
+		if (value.empty() || value == "<empty>") {
+			_search.getTablebase().close();
+		} else if (_search.getTablebase().open(value) == 0) {
+			send("info string no tablebases found in " + value);
+		}
+	} else if (name == "SearchStats") {
+		_sendStats = value == "true";
+	} else {
+		send("info string unknown option " + name);
+	}
+}
+
+void Uci::think() {
+	/*
+	 * Body of the search thread: searches the current game and sends the chosen move.
+	 * Infinite and pondering searches may end early, but their move waits for "stop" or "ponderhit".
+	 */
+
+	std::tuple<Move, int> choice = _search.botChoice(_game);
+	Move move = std::get<0>(choice);
+	long long elapsed = _search.getTimeManager().getElapsed();
+	unsigned long long nodes = _search.getNodes();
+
+	{
+		std::unique_lock<std::mutex> lock(_stopMutex);
+
+		_stopCondition.wait(lock, [this] { return _stopRequested || !_infinite; });
+	}
+
+	send("info depth " + std::to_string(_search.getCompletedDepth()) +
+			" score " + toScore(std::get<1>(choice)) +
+			" nodes " + std::to_string(nodes) +
+			" nps " + std::to_string(elapsed > 0 ? nodes*1000/elapsed : nodes) +
+			" time " + std::to_string(elapsed));
+
+	if (_sendStats) {
+		send("info string stats " + _search.getStats().toJson());
+	}
+
+	if (move.getInitial() == Position(-1, -1)) {
+		send("bestmove 0000");
+	} else {
+		send("bestmove " + toAlgebraic(_game, move));
+	}
+}
+
+void Uci::ponderHit() {
+	/*
+	 * The opponent played the move being pondered on: the search limits apply from now on,
+	 * and the move is sent as soon as the search ends.
+	 */
+
+	_search.getTimeManager().ponderHit();
+
+	if (_searchThread.joinable()) {
+		std::lock_guard<std::mutex> lock(_stopMutex);
+
+		_infinite = false;
+		_stopCondition.notify_one();
+	}
+}
+
+void Uci::stopSearch() {
+	/*
+	 * Stops the running search, if any, and waits until its move is sent.
+	 */
+
+	if (_searchThread.joinable()) {
+		{
+			std::lock_guard<std::mutex> lock(_stopMutex);
+
+			_stopRequested = true;
+			_stopCondition.notify_one();
+		}
+
+		_search.stop();
+		_searchThread.join();
+	}
+}
+
+void Uci::send(const std::string line) {
+	/*
+	 * Writes a line to the standard output, one thread at a time.
+	 */
+
+	std::lock_guard<std::mutex> lock(_outputMutex);
+
+	std::cout << line << std::endl;
+}
+
+std::string Uci::toScore(const int score) const {
+	/*
+	 * Returns the score in UCI notation: centipawns, or turns until the king is killed if the search found it.
+	 */
+
+	if (score >= Search::MIN_WIN_SCORE) {
+		return "mate " + std::to_string((Search::WIN_SCORE - score)/2 + 1);
+	} else if (score <= -Search::MIN_WIN_SCORE) {
+		return "mate " + std::to_string(-((Search::WIN_SCORE + score + 1)/2));
+	}
+
+	return "cp " + std::to_string(score);
+}
+
+std::string Uci::toAlgebraic(const Game &game, const Move move) const {
+	/*
+	 * Returns the move in UCI notation, adding the queen promotion suffix when a pawn reaches the last row.
+	 */
+
+	if (game.getPieceType(toSquare(move.getInitial())) == PAWN && (move.getFinal().getY() == 0 || move.getFinal().getY() == 7)) {
+		return move.toAlgebraic() + "q";
+	}
+
+	return move.toAlgebraic();
+}
@@ -0,0 +1,655 @@
+#include "Worker.h"
+#include <algorithm>
+#include <thread>
+#include "Search.h"
+#include "Trace.h"
+
+static int toTableScore(const int score, const int ply) {
+	/*
+	 * Converts a score to be stored in the transposition table: winning scores count turns from the stored
+	 * game state instead of from the searched one, so they stay right when reached through another path.
+	 */
+
+	if (score >= Search::MIN_WIN_SCORE) {
+		return score + ply;
+	} else if (score <= -Search::MIN_WIN_SCORE) {
+		return score - ply;
+	}
+
+	return score;
+}
+
+static int fromTableScore(const int score, const int ply) {
+	/*
+	 * Converts a score read from the transposition table back to one counted from the searched game state.
+	 */
+
+	if (score >= Search::MIN_WIN_SCORE) {
+		return score - ply;
+	} else if (score <= -Search::MIN_WIN_SCORE) {
+		return score + ply;
+	}
+
+	return score;
+}
+
+Worker::Worker(Search &search, const int index) : _search(search), _index(index), _nodes(0), _reportedNodes(0),
+		_completedDepth(0), _chosenMove(NO_MOVE), _chosenScore(0), _splitPoint(NULL) {}
+
+void Worker::init(const Game &game, const std::vector<CompactMove> &moves) {
+	/*
+	 * Prepares the worker for a new search.
+	 * Game game: game whose active player has to move.
+	 * vector<CompactMove> moves: legal moves of the active player.
+	 */
+
+	// Copy the game once, the whole simulation plays and takes back moves on it
+	_game = game;
+	_moves = moves;
+
+	// Helpers try the moves in a different order so they don't all search the same lines
+	if (_index > 0) {
+		std::rotate(_moves.begin(), _moves.begin() + _index % _moves.size(), _moves.end());
+	}
+
+	_nodes = 0;
+	_reportedNodes = 0;
+	_stats = SearchStats();
+	_completedDepth = 0;
+	_chosenMove = _moves[0];
+	_chosenScore = 0;
+	_splitPoint = NULL;
+	_ordering.age();
+}
+
+void Worker::iterate() {
+	/*
+	 * Searches one turn deeper each iteration until a limit is reached or the search is stopped.
+	 * Only the main worker (index 0) checks the time limits; helpers search until stopped.
+	 */
+
+	int maxDepth = _search.getTimeManager().getMaxDepth();
+	int depth;
+	unsigned long long iterationStart;
+	unsigned long long previousNodes = 0;
+	bool completed;
+
+	if (maxDepth <= 0 || maxDepth > Search::MAX_DEPTH) {
+		maxDepth = Search::MAX_DEPTH;
+	}
+
+	for (int iteration = 1; iteration <= maxDepth; iteration++) {
+		// Don't start an iteration that won't have time to finish
+		if (_index == 0 && iteration > 1 && !_search.getTimeManager().canStartIteration()) {
+			break;
+		}
+
+		if (iteration > 1 && _search.isStopped()) {
+			break;
+		}
+
+		// Half of the helpers search one turn deeper than the main worker
+		depth = iteration + (_index % 2);
+		depth = depth > maxDepth ? maxDepth : depth;
+
+		iterationStart = _nodes;
+
+		TRACE_SPAN("Worker::searchRoot", "search");
+
+		// An aborted iteration gives no score, keep the last completed one
+		completed = searchRoot(depth);
+
+		TRACE_SPAN_ARGS("{\"depth\":" + std::to_string(depth) + ",\"completed\":" + (completed ? "true" : "false") +
+				",\"nodes\":" + std::to_string(_nodes - iterationStart) + "," + Trace::takeTotals() + "}");
+
+		if (!completed) {
+			break;
+		}
+
+		_completedDepth = depth;
+
+		// Nodes of this iteration over nodes of the one before
+		_stats.branchingFactor = previousNodes > 0 ? (double) (_nodes - iterationStart)/previousNodes : 0.0;
+		previousNodes = _nodes - iterationStart;
+
+		// Let the thread that started the search show its progress
+		if (_index == 0) {
+			_search.report(depth, _chosenMove, _chosenScore);
+		}
+
+		// There is nothing to think about with a single legal move
+		if (_moves.size() == 1) {
+			break;
+		}
+
+		// Search the chosen move first in the next iteration
+		for (unsigned int i = 0; i < _moves.size(); i++) {
+			if (_moves[i] == _chosenMove) {
+				_moves.erase(_moves.begin() + i);
+				_moves.insert(_moves.begin(), _chosenMove);
+				break;
+			}
+		}
+	}
+
+	// The main worker is done, so are the helpers
+	if (_index == 0) {
+		_search.stop();
+	}
+}
+
+void Worker::help() {
+	/*
+	 * Helper loop of the SPLIT_POINTS mode: searches tasks stolen from other workers until the search is stopped.
+	 */
+
+	Task task;
+
+	while (!_search.isStopped()) {
+		if (_search.stealTask(task, _index)) {
+			runTask(task);
+		} else {
+			std::this_thread::yield();
+		}
+	}
+}
+
+bool Worker::searchRoot(const int depth) {
+	/*
+	 * Scores every legal move with a search of the given depth.
+	 * Every move that could tie with the best one gets its exact score, so the random choice
+	 * among equally scored moves is the same as with a full simulation.
+	 * Returns false if the search was stopped before all moves got their score.
+	 * int depth: turns to simulate, including the current one.
+	 */
+
+	std::vector<CompactMove> bestMoves;
+	int score;
+	int maxScore = -Search::INFINITE_SCORE;
+
+	for (auto &move : _moves) {
+		if (_game.isGameOver(move)) {
+			score = scoreGameOver(move, 0);
+		} else {
+			_game.makeMove(move);
+
+			// Only scores that could reach the current maximum need to be exact
+			score = -negamax(depth - 1, 1, -Search::INFINITE_SCORE, -maxScore + 1);
+
+			_game.unmakeMove();
+
+			if (isAborted()) {
+				return false;
+			}
+		}
+
+		_nodes++;
+
+		// Update list of best moves and the best score achieved
+		if (score > maxScore) {
+			bestMoves.clear();
+			bestMoves.push_back(move);
+			maxScore = score;
+		} else if (score == maxScore) {
+			bestMoves.push_back(move);
+		}
+	}
+
+	// Choose a random move from the best moves list (helpers just take the first one)
+	_chosenMove = _index == 0 ? bestMoves[rand() % bestMoves.size()] : bestMoves[0];
+	_chosenScore = maxScore;
+
+	return true;
+}
+
+int Worker::negamax(const int depth, const int ply, int alpha, const int beta) {
+	/*
+	 * Alpha-beta search of the active player moves, in negamax form and with fail-soft bounds.
+	 * Game states are evaluated from the active player side once no turns are left to simulate.
+	 * Returns the best score found, which is exact only if it is inside (alpha, beta).
+	 * int depth: turns left to simulate, including the current one.
+	 * int ply: turns simulated from the searched game state.
+	 * int alpha: score the active player is already guaranteed elsewhere.
+	 * int beta: score the opponent is already guaranteed elsewhere.
+	 */
+
+	// Past the last simulated turn only kills are searched
+	if (depth == 0) {
+		return quiescence(ply, alpha, beta);
+	}
+
+	MoveList moves;
+	int scores[MoveList::MAX_MOVES];
+	CompactMove bestMove = NO_MOVE;
+	CompactMove tableMove = NO_MOVE;
+	int score;
+	int bestScore = -Search::INFINITE_SCORE;
+	int alphaOrigin = alpha;
+	int tableDepth;
+	int tableScore;
+	int tableBound;
+
+	// Scores only depend on the game state if no draw by noKillTurns can happen below it
+	// (kills searched past the last turn reset the counter, so they never draw)
+	bool useTable = _game.getNoKillTurns() + depth < 50;
+
+	// Only split nodes deep enough to be worth sharing, once their first move is searched
+	bool canSplit = depth >= MIN_SPLIT_DEPTH && _search.getParallelMode() == Search::SPLIT_POINTS && _search.getThreads() > 1;
+
+	countNode();
+
+	if (isAborted()) {
+		return 0;
+	}
+
+	// Endgames in the tables need no search, unless the 50 turns rule could change their result.
+	// Counting the pieces first keeps the probe out of the way while there are too many for the tables
+	if (ply > 0 && popCount(_game.getOccupancy(BLACK) | _game.getOccupancy(WHITE)) <= _search.getTablebase().getMaxPieces() &&
+			_search.getTablebase().probe(_game, tableScore) && Tablebase::isSound(tableScore, _game.getNoKillTurns())) {
+		return Search::fromTablebase(tableScore, ply);
+	}
+
+	// Reuse a previous result for the same state if it was searched deep enough
+	if (useTable) {
+		_stats.probes++;
+
+		if (_search.getTable().probe(_game.getKey(), tableDepth, tableScore, tableBound, tableMove)) {
+			_stats.hits++;
+			tableScore = fromTableScore(tableScore, ply);
+
+			if (tableDepth >= depth && (tableBound == TranspositionTable::EXACT ||
+					(tableBound == TranspositionTable::LOWER && tableScore >= beta) ||
+					(tableBound == TranspositionTable::UPPER && tableScore <= alpha))) {
+				return tableScore;
+			}
+		}
+	}
+
+	_game.generateMoves(moves);
+	_ordering.score(_game, moves, scores, tableMove, ply);
+
+	// Iterate through all the legal moves of the active player, most promising first
+	for (int i = 0; i < moves.size(); i++) {
+		MoveOrdering::pick(moves, scores, i);
+
+		CompactMove move = moves.get(i);
+
+		if (_game.isGameOver(move)) {
+			score = scoreGameOver(move, ply);
+		} else {
+			_game.makeMove(move);
+			score = -negamax(depth - 1, ply + 1, -beta, -alpha);
+			_game.unmakeMove();
+
+			if (isAborted()) {
+				return 0;
+			}
+		}
+
+		if (score > bestScore) {
+			bestScore = score;
+			bestMove = move;
+
+			if (score > alpha) {
+				alpha = score;
+
+				// The opponent will never allow this line
+				if (alpha >= beta) {
+					_ordering.update(_game, move, depth, ply);
+					_stats.cutoffs++;
+					_stats.firstMoveCutoffs += i == 0;
+
+					if (useTable) {
+						_search.getTable().store(_game.getKey(), depth, toTableScore(bestScore, ply), TranspositionTable::LOWER, bestMove);
+					}
+
+					return bestScore;
+				}
+			}
+		}
+
+		// Young Brothers Wait: the first move is searched, the rest can be searched in parallel
+		if (canSplit && i + 1 < moves.size()) {
+			split(depth, ply, alpha, beta, bestScore, bestMove, moves, scores, i + 1);
+
+			if (isAborted()) {
+				return 0;
+			}
+
+			if (bestScore >= beta) {
+				_stats.cutoffs++;
+
+				if (useTable) {
+					_search.getTable().store(_game.getKey(), depth, toTableScore(bestScore, ply), TranspositionTable::LOWER, bestMove);
+				}
+
+				return bestScore;
+			}
+
+			// Every move has been searched
+			break;
+		}
+
+		canSplit = false;
+	}
+
+	// No legal moves left
+	if (bestScore == -Search::INFINITE_SCORE) {
+		return 0;
+	}
+
+	if (useTable) {
+		_search.getTable().store(_game.getKey(), depth, toTableScore(bestScore, ply),
+				bestScore > alphaOrigin ? TranspositionTable::EXACT : TranspositionTable::UPPER, bestMove);
+	}
+
+	return bestScore;
+}
+
+int Worker::quiescence(const int ply, int alpha, const int beta) {
+	/*
+	 * Searches only the kills of the active player once the last turn has been simulated, so that scores
+	 * are never taken in the middle of a kill exchange.
+	 * The active player may also stop killing (stand pat), which keeps the current score.
+	 * Returns the best score found, which is exact only if it is inside (alpha, beta).
+	 * int ply: turns simulated from the searched game state.
+	 * int alpha: score the active player is already guaranteed elsewhere.
+	 * int beta: score the opponent is already guaranteed elsewhere.
+	 */
+
+	MoveList moves;
+	int scores[MoveList::MAX_MOVES];
+	int score;
+	int standPat = _game.evaluate();
+	int bestScore = standPat;
+
+	countNode();
+	_stats.quiescenceNodes++;
+
+	if (isAborted()) {
+		return 0;
+	}
+
+	if (bestScore >= beta) {
+		return bestScore;
+	}
+
+	if (bestScore > alpha) {
+		alpha = bestScore;
+	}
+
+	_game.generateKills(moves);
+	_ordering.score(_game, moves, scores, NO_MOVE, ply);
+
+	for (int i = 0; i < moves.size(); i++) {
+		MoveOrdering::pick(moves, scores, i);
+
+		CompactMove move = moves.get(i);
+
+		// Delta pruning: skip kills that can't raise the score to alpha even if nothing is lost afterwards
+		if (standPat + _game.getPiece(toPosition(move.getFinal())).getValue() + DELTA_MARGIN <= alpha) {
+			continue;
+		}
+
+		if (_game.isGameOver(move)) {
+			score = scoreGameOver(move, ply);
+		} else {
+			_game.makeMove(move);
+			score = -quiescence(ply + 1, -beta, -alpha);
+			_game.unmakeMove();
+
+			if (isAborted()) {
+				return 0;
+			}
+		}
+
+		if (score > bestScore) {
+			bestScore = score;
+
+			if (score > alpha) {
+				alpha = score;
+
+				if (alpha >= beta) {
+					return bestScore;
+				}
+			}
+		}
+	}
+
+	return bestScore;
+}
+
+void Worker::countNode() {
+	/*
+	 * Counts a visited node, publishing the count every 1024 nodes for other threads to read.
+	 * The main worker also checks the limits then, aborting every worker if any is reached.
+	 */
+
+	_nodes++;
+
+	if ((_nodes & 1023) == 0) {
+		_reportedNodes.store(_nodes, std::memory_order_relaxed);
+
+		if (_index == 0 && _search.getTimeManager().mustStop(_nodes)) {
+			_search.stop();
+		}
+	}
+}
+
+int Worker::scoreGameOver(const CompactMove move, const int ply) const {
+	/*
+	 * Scores a move that ends the game: killing the king wins, sooner wins scoring more,
+	 * and reaching 50 turns without a kill is a draw.
+	 * Returns the score of the move for the active player.
+	 * CompactMove move: move that ends the game.
+	 * int ply: turns simulated from the searched game state.
+	 */
+
+	return _game.getPieceType(move.getFinal()) == KING ? Search::WIN_SCORE - ply : 0;
+}
+
+void Worker::split(const int depth, const int ply, const int alpha, const int beta, int &bestScore, CompactMove &bestMove,
+		MoveList &moves, int scores[], const int first) {
+	/*
+	 * Publishes the remaining moves of the current node as tasks, searches them along with any
+	 * worker that steals them and waits until all of them are done.
+	 * int depth, ply, alpha, beta: search parameters of the node.
+	 * int bestScore, CompactMove bestMove: best result so far, updated with the results of the tasks.
+	 * MoveList moves: legal moves of the node.
+	 * int scores[]: ordering score of every move.
+	 * int first: index of the first move not searched yet.
+	 */
+
+	SplitPoint splitPoint;
+	SplitPoint *previous = _splitPoint;
+	Task task;
+
+	splitPoint.parent = _splitPoint;
+	splitPoint.game = _game;
+	splitPoint.depth = depth;
+	splitPoint.ply = ply;
+	splitPoint.beta = beta;
+	splitPoint.alpha = alpha;
+	splitPoint.cutoff = false;
+	splitPoint.pending = 0;
+	splitPoint.bestScore = bestScore;
+	splitPoint.bestMove = bestMove;
+
+	task.splitPoint = &splitPoint;
+
+	// Publish every remaining move, most promising first
+	for (int i = first; i < moves.size(); i++) {
+		MoveOrdering::pick(moves, scores, i);
+
+		task.move = moves.get(i);
+
+		splitPoint.pending++;
+		_tasks.push(task);
+	}
+
+	// Search the tasks nobody stole, in place
+	_splitPoint = &splitPoint;
+
+	while (_tasks.popBack(task, &splitPoint)) {
+		searchTask(task);
+	}
+
+	_splitPoint = previous;
+
+	// Search tasks of other workers while the stolen ones are being searched
+	while (splitPoint.pending > 0) {
+		if (_index == 0 && _search.getTimeManager().mustStop(_nodes)) {
+			_search.stop();
+		}
+
+		if (_search.stealTask(task, _index)) {
+			runTask(task);
+		} else {
+			std::this_thread::yield();
+		}
+	}
+
+	bestScore = splitPoint.bestScore;
+	bestMove = splitPoint.bestMove;
+}
+
+void Worker::searchTask(const Task &task) {
+	/*
+	 * Searches a task on the worker game, which must be at the split point state.
+	 */
+
+	SplitPoint &splitPoint = *task.splitPoint;
+	int score;
+	int alpha;
+
+	if (!isAborted()) {
+		alpha = splitPoint.alpha;
+
+		if (_game.isGameOver(task.move)) {
+			score = scoreGameOver(task.move, splitPoint.ply);
+		} else {
+			_game.makeMove(task.move);
+			score = -negamax(splitPoint.depth - 1, splitPoint.ply + 1, -splitPoint.beta, -alpha);
+			_game.unmakeMove();
+		}
+
+		// Share the result unless the search was aborted meanwhile
+		if (!isAborted()) {
+			std::lock_guard<std::mutex> lock(splitPoint.mutex);
+
+			if (score > splitPoint.bestScore) {
+				splitPoint.bestScore = score;
+				splitPoint.bestMove = task.move;
+
+				if (score > splitPoint.alpha) {
+					splitPoint.alpha = score;
+
+					if (score >= splitPoint.beta) {
+						splitPoint.cutoff = true;
+					}
+				}
+			}
+		}
+	}
+
+	// Last access to the split point, its owner may leave right after
+	splitPoint.pending--;
+}
+
+void Worker::runTask(const Task &task) {
+	/*
+	 * Searches a task stolen from another worker, keeping the worker own game state untouched.
+	 */
+
+	Game saved;
+	SplitPoint *previous = _splitPoint;
+
+	saved = _game;
+	_game = task.splitPoint->game;
+	_splitPoint = task.splitPoint;
+
+	searchTask(task);
+
+	_splitPoint = previous;
+	_game = saved;
+}
+
+bool Worker::steal(Task &task) {
+	/*
+	 * Lets another worker steal one of the tasks published by this one.
+	 * Returns true if a task was stolen.
+	 */
+
+	return _tasks.steal(task);
+}
+
+bool Worker::isAborted() const {
+	/*
+	 * Returns true if the search was stopped or a split point the worker is searching for has been cut off.
+	 */
+
+	if (_search.isStopped()) {
+		return true;
+	}
+
+	for (SplitPoint *splitPoint = _splitPoint; splitPoint != NULL; splitPoint = splitPoint->parent) {
+		if (splitPoint->cutoff.load(std::memory_order_relaxed)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+unsigned long long Worker::getNodes() const {
+	/*
+	 * Returns the number of nodes visited during the last search.
+	 */
+
+	return _nodes;
+}
+
+unsigned long long Worker::getReportedNodes() const {
+	/*
+	 * Returns the number of nodes visited so far, as last published by the searching thread.
+	 * Unlike getNodes, it can be read while the search is running.
+	 */
+
+	return _reportedNodes.load(std::memory_order_relaxed);
+}
+
+SearchStats Worker::getStats() const {
+	/*
+	 * Returns the counters of the last search, including the nodes visited.
+	 */
+
+	SearchStats stats = _stats;
+
+	stats.nodes = _nodes;
+
+	return stats;
+}
+
+int Worker::getCompletedDepth() const {
+	/*
+	 * Returns the depth of the last completed iteration.
+	 */
+
+	return _completedDepth;
+}
+
+CompactMove Worker::getChosenMove() const {
+	/*
+	 * Returns the move chosen by the last completed iteration.
+	 */
+
+	return _chosenMove;
+}
+
+int Worker::getChosenScore() const {
+	/*
+	 * Returns the score of the move chosen by the last completed iteration.
+	 */
+
+	return _chosenScore;
+}
@@ -0,0 +1,50 @@
+#include <fstream>
+#include <iostream>
+#include <string.h>
+#include "Book.h"
+
+using namespace std;
+
+int main(int argc, char* argv[]) {
+	string gamesPath;
+	string bookPath = "book.bin";
+	int maxPlies = Book::DEFAULT_PLIES;
+	int minCount = 1;
+
+	// Read command line options
+	for (int i = 1; i + 1 < argc; i += 2) {
+		if (strcmp(argv[i], "-games") == 0) {
+			gamesPath = argv[i + 1];
+		} else if (strcmp(argv[i], "-book") == 0) {
+			bookPath = argv[i + 1];
+		} else if (strcmp(argv[i], "-plies") == 0) {
+			maxPlies = atoi(argv[i + 1]);
+		} else if (strcmp(argv[i], "-min") == 0) {
+			minCount = atoi(argv[i + 1]);
+		}
+	}
+
+	ifstream games(gamesPath);
+	ofstream book(bookPath, ios::binary);
+
+	if (!games) {
+		cout << "Error opening games " << gamesPath << endl;
+		return 1;
+	}
+
+	if (!book) {
+		cout << "Error creating book " << bookPath << endl;
+		return 1;
+	}
+
+	long long entries = Book::build(games, book, maxPlies, minCount);
+
+	if (entries < 0) {
+		cout << "Error writing book " << bookPath << endl;
+		return 1;
+	}
+
+	cout << "Book entries: " << entries << endl;
+
+	return 0;
+}
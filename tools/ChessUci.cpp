@@ -0,0 +1,12 @@
+#include "Uci.h"
+
+int main() {
+
+	// Seed random generator used to choose between equally scored moves
+	srand(time(0));
+
+	Uci uci;
+	uci.loop();
+
+	return 0;
+}
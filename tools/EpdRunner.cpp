@@ -0,0 +1,74 @@
+#include <fstream>
+#include <iostream>
+#include <string.h>
+#include "Bench.h"
+#include "TestSuite.h"
+#include "Trace.h"
+
+using namespace std;
+
+int main(int argc, char* argv[]) {
+	string epdPath;
+	string tracePath;
+	long long moveTime = 0;
+	unsigned long long maxNodes = 0;
+	int maxDepth = 0;
+	int jobs = 1;
+	int threads = 1;
+	int parallelMode = Search::LAZY_SMP;
+	int hashSize = TestSuite::DEFAULT_HASH_SIZE;
+	TestSuite suite;
+
+	// Read command line options
+	for (int i = 1; i + 1 < argc; i += 2) {
+		if (strcmp(argv[i], "-epd") == 0) {
+			epdPath = argv[i + 1];
+		} else if (strcmp(argv[i], "-movetime") == 0) {
+			moveTime = atoll(argv[i + 1]);
+		} else if (strcmp(argv[i], "-nodes") == 0) {
+			maxNodes = strtoull(argv[i + 1], NULL, 10);
+		} else if (strcmp(argv[i], "-depth") == 0) {
+			maxDepth = atoi(argv[i + 1]);
+		} else if (strcmp(argv[i], "-jobs") == 0) {
+			jobs = atoi(argv[i + 1]);
+		} else if (strcmp(argv[i], "-threads") == 0) {
+			threads = atoi(argv[i + 1]);
+		} else if (strcmp(argv[i], "-parallel") == 0) {
+			parallelMode = strcmp(argv[i + 1], "split") == 0 ? Search::SPLIT_POINTS : Search::LAZY_SMP;
+		} else if (strcmp(argv[i], "-hash") == 0) {
+			hashSize = atoi(argv[i + 1]);
+		} else if (strcmp(argv[i], "-trace") == 0) {
+			tracePath = argv[i + 1];
+		}
+	}
+
+	ifstream epd(epdPath);
+
+	if (!epd) {
+		cout << "Error opening positions " << epdPath << endl;
+		return 1;
+	}
+
+	int skipped = suite.load(epd);
+
+	if (skipped > 0) {
+		cout << "Skipped " << skipped << " positions that can't be played under this game rules" << endl;
+	}
+
+	// Searches need some limit to end
+	if (moveTime <= 0 && maxNodes == 0 && maxDepth <= 0) {
+		maxDepth = Bench::DEFAULT_DEPTH;
+	}
+
+	suite.setLimits(moveTime, maxNodes, maxDepth);
+	suite.setSearch(threads, parallelMode, hashSize);
+
+	if (!tracePath.empty() && !Trace::open(tracePath)) {
+		cout << "Error opening trace " << tracePath << " (tracing needs a build with -DCHESS_TRACE)" << endl;
+	}
+
+	suite.run(jobs > 0 ? jobs : 1, cout);
+	Trace::close();
+
+	return 0;
+}
@@ -0,0 +1,128 @@
+#include <fstream>
+#include <iostream>
+#include <string.h>
+#include "Match.h"
+
+using namespace std;
+
+static bool readEngineOption(const char *option, const char *value, const char *name, EngineOptions options[2]) {
+	/*
+	 * Reads a limit given for both engines as "-name", or for one of them as "-name1" or "-name2".
+	 * Returns true if the option is the limit.
+	 */
+
+	size_t length = strlen(name);
+
+	if (option[0] != '-' || strncmp(option + 1, name, length) != 0) {
+		return false;
+	}
+
+	const char *engine = option + 1 + length;
+
+	if (engine[0] != '\0' && (strcmp(engine, "1") != 0 && strcmp(engine, "2") != 0)) {
+		return false;
+	}
+
+	for (int i = 0; i < 2; i++) {
+		if (engine[0] != '\0' && engine[0] - '1' != i) {
+			continue;
+		}
+
+		if (strcmp(name, "engine") == 0) {
+			options[i].command = value;
+			options[i].name = value;
+		} else if (strcmp(name, "name") == 0) {
+			options[i].name = value;
+		} else if (strcmp(name, "movetime") == 0) {
+			options[i].moveTime = atoll(value);
+		} else if (strcmp(name, "nodes") == 0) {
+			options[i].maxNodes = strtoull(value, NULL, 10);
+		} else if (strcmp(name, "depth") == 0) {
+			options[i].maxDepth = atoi(value);
+		} else if (strcmp(name, "threads") == 0) {
+			options[i].threads = atoi(value);
+		} else if (strcmp(name, "hash") == 0) {
+			options[i].hashSize = atoi(value);
+		}
+	}
+
+	return true;
+}
+
+int main(int argc, char* argv[]) {
+	const char *engineOptions[] = {"engine", "name", "movetime", "nodes", "depth", "threads", "hash"};
+	EngineOptions options[2];
+	string openingsPath;
+	int games = Match::DEFAULT_GAMES;
+	int concurrency = 1;
+	int plies = Match::DEFAULT_OPENING_PLIES;
+	double elo0 = 0;
+	double elo1 = 5;
+	double alpha = 0.05;
+	double beta = 0.05;
+	bool sprt = true;
+
+	for (int i = 0; i < 2; i++) {
+		options[i].name = i == 0 ? "first" : "second";
+		options[i].moveTime = 0;
+		options[i].maxNodes = 0;
+		options[i].maxDepth = 0;
+		options[i].threads = 1;
+		options[i].hashSize = TranspositionTable::DEFAULT_SIZE;
+	}
+
+	// Read command line options
+	for (int i = 1; i + 1 < argc; i += 2) {
+		if (strcmp(argv[i], "-games") == 0) {
+			games = atoi(argv[i + 1]);
+		} else if (strcmp(argv[i], "-concurrency") == 0) {
+			concurrency = atoi(argv[i + 1]);
+		} else if (strcmp(argv[i], "-openings") == 0) {
+			openingsPath = argv[i + 1];
+		} else if (strcmp(argv[i], "-plies") == 0) {
+			plies = atoi(argv[i + 1]);
+		} else if (strcmp(argv[i], "-seed") == 0) {
+			srand(atoi(argv[i + 1]));
+		} else if (strcmp(argv[i], "-elo0") == 0) {
+			elo0 = atof(argv[i + 1]);
+		} else if (strcmp(argv[i], "-elo1") == 0) {
+			elo1 = atof(argv[i + 1]);
+		} else if (strcmp(argv[i], "-alpha") == 0) {
+			alpha = atof(argv[i + 1]);
+		} else if (strcmp(argv[i], "-beta") == 0) {
+			beta = atof(argv[i + 1]);
+		} else if (strcmp(argv[i], "-sprt") == 0) {
+			sprt = strcmp(argv[i + 1], "off") != 0;
+		} else {
+			for (auto name : engineOptions) {
+				if (readEngineOption(argv[i], argv[i + 1], name, options)) {
+					break;
+				}
+			}
+		}
+	}
+
+	// Games need some limit to end every move
+	for (int i = 0; i < 2; i++) {
+		if (options[i].moveTime <= 0 && options[i].maxNodes == 0 && options[i].maxDepth <= 0) {
+			options[i].moveTime = Match::DEFAULT_MOVE_TIME;
+		}
+	}
+
+	Match match(options[0], options[1]);
+
+	if (!openingsPath.empty()) {
+		ifstream openings(openingsPath);
+
+		if (!openings || match.loadOpenings(openings) == 0) {
+			cout << "Error reading openings " << openingsPath << endl;
+			return 1;
+		}
+	} else {
+		match.generateOpenings((games + 1)/2, plies);
+	}
+
+	match.setSprt(Sprt(elo0, elo1, alpha, beta), sprt);
+
+	return match.run(games, concurrency > 0 ? concurrency : 1, cout) < 0 ? 1 : 0;
+}
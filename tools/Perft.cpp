@@ -0,0 +1,43 @@
+#include <iostream>
+#include <string.h>
+#include "Game.h"
+#include "Perft.h"
+
+using namespace std;
+
+int main(int argc, char* argv[]) {
+	int depth = Perft::DEFAULT_DEPTH;
+	int divideDepth = 0;
+	string moves;
+
+	// Read command line options
+	for (int i = 1; i + 1 < argc; i += 2) {
+		if (strcmp(argv[i], "-depth") == 0) {
+			depth = atoi(argv[i + 1]);
+		} else if (strcmp(argv[i], "-divide") == 0) {
+			divideDepth = atoi(argv[i + 1]);
+		} else if (strcmp(argv[i], "-moves") == 0) {
+			moves = argv[i + 1];
+		} else if (strcmp(argv[i], "-sliders") == 0) {
+			initSliderAttacks(strcmp(argv[i + 1], "pext") == 0);
+		}
+	}
+
+	cout << "Slider attacks: " << (isPextEnabled() ? "pext" : "magic") << endl;
+
+	// Print the count below every first move of a single game state
+	if (divideDepth > 0) {
+		Game game(Game::BOTVBOT);
+
+		if (!game.playMoves(moves)) {
+			cout << "Illegal moves " << moves << endl;
+			return 1;
+		}
+
+		Perft::divide(game, divideDepth);
+		return 0;
+	}
+
+	// Check and time every reference game state
+	return Perft::runReference(depth) ? 0 : 1;
+}
@@ -0,0 +1,54 @@
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <string.h>
+#include "Tablebase.h"
+
+using namespace std;
+
+int main(int argc, char* argv[]) {
+	string directory = "tablebases";
+	string material;
+	int pieces = 4;
+	long long counts[3];
+	vector<string> materials;
+
+	// Read command line options
+	for (int i = 1; i + 1 < argc; i += 2) {
+		if (strcmp(argv[i], "-dir") == 0) {
+			directory = argv[i + 1];
+		} else if (strcmp(argv[i], "-pieces") == 0) {
+			pieces = atoi(argv[i + 1]);
+		} else if (strcmp(argv[i], "-material") == 0) {
+			material = argv[i + 1];
+		}
+	}
+
+	// A single material, or every one up to the given number of pieces, each after those it depends on
+	if (!material.empty()) {
+		materials.push_back(material);
+	} else {
+		for (int i = 2; i <= pieces && i <= Tablebase::MAX_PIECES; i++) {
+			for (auto &name : Tablebase::listMaterials(i)) {
+				materials.push_back(name);
+			}
+		}
+	}
+
+	filesystem::create_directories(directory);
+
+	for (auto &name : materials) {
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		long long size = Tablebase::generate(name, directory, counts);
+
+		if (size < 0) {
+			cout << "Error generating " << name << endl;
+			return 1;
+		}
+
+		cout << name << ": " << counts[0] << " won, " << counts[1] << " lost, " << counts[2] << " drawn, " <<
+				chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count() << " ms" << endl;
+	}
+
+	return 0;
+}